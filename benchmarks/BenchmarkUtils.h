@@ -0,0 +1,19 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/// Timing and reporting shared by all benchmarks
+
+typedef std::chrono::high_resolution_clock Clock;
+
+inline double milliseconds(const Clock::time_point & start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/// One line of results - name padded to nameWidth, time in milliseconds
+inline void report(const char * name, const double & time, const int & nameWidth = 24) {
+    std::cout << "  " << std::setw(nameWidth) << std::left << name << std::right
+              << std::fixed << std::setprecision(3) << std::setw(12) << time << " ms" << std::endl;
+}
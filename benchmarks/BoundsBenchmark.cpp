@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <Rendering/Mesh/Mesh.h>
+
+#include "BenchmarkUtils.h"
+
+/// Bounds of 1M vertex mesh: scalar reduction vs Mesh::computeBounds, then preprocessing of 1000 instances
+/// with previous per instance vertex walk vs bounds cached on the mesh.
+
+namespace {
+
+    /// Previous per instance walk of BoundingBoxGenerator (with lowest() instead of min() for max)
+    void scalarBounds(const Mesh & mesh, glm::vec3 & min, glm::vec3 & max) {
+        min = glm::vec3(std::numeric_limits<float>::max());
+        max = glm::vec3(std::numeric_limits<float>::lowest());
+
+        for (size_t i = 0; i + 2 < mesh.vertices.size(); i += 3) {
+            glm::vec3 vertex(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+            min = glm::min(min, vertex);
+            max = glm::max(max, vertex);
+        }
+    }
+}
+
+int main() {
+    const size_t vertexCount = 1000000;
+    const int instances = 1000;
+
+    Mesh mesh;
+    mesh.vertices.reserve(vertexCount * 3);
+
+    for (size_t i = 0; i < vertexCount; i++) {
+        float t = static_cast<float>(i) * 0.001f;
+        mesh.vertices.insert(mesh.vertices.end(), { std::sin(t) * 50.0f, std::cos(t * 0.7f) * 20.0f, t * 0.01f });
+    }
+
+    double bestScalar = 1e30;
+    double bestMesh = 1e30;
+
+    glm::vec3 min, max;
+
+    for (int r = 0; r < 10; r++) {
+        auto start = Clock::now();
+        scalarBounds(mesh, min, max);
+        bestScalar = std::min(bestScalar, milliseconds(start));
+
+        start = Clock::now();
+        mesh.computeBounds();
+        bestMesh = std::min(bestMesh, milliseconds(start));
+    }
+
+    if (min != mesh.boundsMin || max != mesh.boundsMax) {
+        std::cout << "  bounds differ" << std::endl;
+    }
+
+    std::cout << "Bounds of " << vertexCount << " vertices" << std::endl;
+    report("scalar min/max", bestScalar, 32);
+    report("Mesh::computeBounds (+ sphere)", bestMesh, 32);
+
+    std::cout << "Preprocessing " << instances << " instances" << std::endl;
+
+    std::vector<glm::vec3> centers(instances);
+
+    auto start = Clock::now();
+
+    for (int i = 0; i < instances; i++) {
+        scalarBounds(mesh, min, max);
+        centers[i] = (min + max) * 0.5f;
+    }
+
+    report("walk per instance (previous)", milliseconds(start), 32);
+
+    start = Clock::now();
+
+    mesh.hasBounds = false;
+    mesh.computeBounds();
+
+    for (int i = 0; i < instances; i++) {
+        centers[i] = mesh.getBoundsCenter();
+    }
+
+    report("cached on mesh", milliseconds(start), 32);
+
+    return 0;
+}
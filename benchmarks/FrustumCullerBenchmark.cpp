@@ -0,0 +1,91 @@
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Rendering/Culling/FrustumCuller/FrustumCuller.h>
+
+#include "BenchmarkUtils.h"
+
+/// Culls 1M instances with every instruction set path on a single thread,
+/// then with the widest path split across all job system workers.
+/// Runs a sparse scene (few objects visible) and a dense one (about half visible).
+
+namespace {
+
+    void fillBounds(FrustumCuller & culler, const float & spread) {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> position(-spread, spread);
+        std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+
+        for (size_t i = 0; i < culler.size(); i++) {
+            culler.setAabb(i, position(random), position(random), position(random), extent(random), extent(random), extent(random));
+        }
+    }
+
+    void run(const char * name, const float & spread, const size_t & count, const int & repetitions) {
+        /// Box frustum from -10 to 10 on every axis
+        glm::vec4 planes[6] = {
+            glm::vec4(-1.0f, 0.0f, 0.0f, 10.0f), glm::vec4(1.0f, 0.0f, 0.0f, 10.0f),
+            glm::vec4(0.0f, 1.0f, 0.0f, 10.0f), glm::vec4(0.0f, -1.0f, 0.0f, 10.0f),
+            glm::vec4(0.0f, 0.0f, -1.0f, 10.0f), glm::vec4(0.0f, 0.0f, 1.0f, 10.0f)
+        };
+
+        FrustumCuller culler;
+        culler.resize(count);
+        fillBounds(culler, spread);
+
+        std::vector<unsigned char> visibility(count);
+
+        CullingPlanes prepared = FrustumCuller::preparePlanes(planes);
+
+        std::cout << name << " (" << count << " instances)" << std::endl;
+
+        for (auto volume : { CullingVolume::Sphere, CullingVolume::Aabb }) {
+            const char * volumeName = volume == CullingVolume::Sphere ? "sphere" : "aabb";
+
+            for (auto path : { CullingPath::Scalar, CullingPath::SSE, CullingPath::AVX2, CullingPath::AVX512 }) {
+                if (!FrustumCuller::isSupported(path)) {
+                    continue;
+                }
+
+                double best = 1e30;
+                size_t visible = 0;
+
+                for (int r = 0; r < repetitions; r++) {
+                    auto start = Clock::now();
+                    visible = culler.cullRange(prepared, volume, path, 0, count, visibility.data());
+                    best = std::min(best, milliseconds(start));
+                }
+
+                std::cout << "  " << std::setw(6) << volumeName << std::setw(9) << FrustumCuller::pathName(path)
+                          << std::fixed << std::setprecision(3) << std::setw(10) << best << " ms"
+                          << std::setw(10) << visible << " visible" << std::endl;
+            }
+
+            double best = 1e30;
+
+            for (int r = 0; r < repetitions; r++) {
+                auto start = Clock::now();
+                culler.cull(planes, volume, visibility.data());
+                best = std::min(best, milliseconds(start));
+            }
+
+            std::cout << "  " << std::setw(6) << volumeName << std::setw(9) << "threaded"
+                      << std::fixed << std::setprecision(3) << std::setw(10) << best << " ms"
+                      << std::setw(10) << culler.getVisibleCount() << " visible" << std::endl;
+        }
+    }
+}
+
+int main() {
+    JobSystem::Instance();
+
+    std::cout << "Widest path: " << FrustumCuller::pathName(FrustumCuller::bestPath()) << std::endl;
+
+    run("Sparse", 60.0f, 1000000, 10);
+    run("Dense", 12.0f, 1000000, 10);
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <Jobs/JobSystem/JobSystem.h>
+
+#include "BenchmarkUtils.h"
+
+/// Measures how job system scales from 1 to all hardware threads on three workloads:
+/// coarse parallelFor (compute bound), fine grained parallelFor (scheduling overhead)
+/// and dependent job chains (counters and dependencies).
+
+namespace {
+
+    double computeBound(JobSystem & jobs, std::vector<float> & data) {
+        auto start = Clock::now();
+
+        jobs.parallelFor(0, data.size(), jobs.defaultGrainSize(data.size()), [&data](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                float x = static_cast<float>(i) * 0.001f;
+                data[i] = std::sin(x) * std::cos(x) + std::sqrt(x);
+            }
+        });
+
+        return milliseconds(start);
+    }
+
+    double fineGrained(JobSystem & jobs, std::vector<float> & data) {
+        auto start = Clock::now();
+
+        jobs.parallelFor(0, data.size(), 64, [&data](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                data[i] = data[i] * 0.5f + 1.0f;
+            }
+        });
+
+        return milliseconds(start);
+    }
+
+    double dependentChains(JobSystem & jobs, const int & chains, const int & length) {
+        auto start = Clock::now();
+
+        std::vector<JobCounter> counters(static_cast<size_t>(chains * length));
+        std::vector<double> results(static_cast<size_t>(chains), 0.0);
+
+        JobCounter all;
+
+        for (int c = 0; c < chains; c++) {
+            for (int l = 0; l < length; l++) {
+                auto & counter = counters[c * length + l];
+                const JobCounter * dependency = l > 0 ? &counters[c * length + l - 1] : nullptr;
+
+                jobs.run([&results, c]() {
+                    double v = results[c];
+                    for (int i = 0; i < 20000; i++) {
+                        v += std::sqrt(static_cast<double>(i));
+                    }
+                    results[c] = v;
+                }, &counter, dependency);
+
+                jobs.run([]() {}, &all, &counter);
+            }
+        }
+
+        jobs.wait(all);
+
+        return milliseconds(start);
+    }
+}
+
+int main() {
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const int repetitions = 5;
+
+    std::vector<float> data(1 << 24);
+
+    std::cout << "threads  compute(ms)  speedup  fine(ms)  speedup  chains(ms)  speedup" << std::endl;
+
+    double base[3] = { 0.0, 0.0, 0.0 };
+
+    for (unsigned int threads = 1; threads <= hardwareThreads; threads++) {
+        JobSystem jobs(threads - 1);
+
+        double best[3] = { 1e30, 1e30, 1e30 };
+
+        for (int r = 0; r < repetitions; r++) {
+            best[0] = std::min(best[0], computeBound(jobs, data));
+            best[1] = std::min(best[1], fineGrained(jobs, data));
+            best[2] = std::min(best[2], dependentChains(jobs, 64, 16));
+        }
+
+        if (threads == 1) {
+            for (int i = 0; i < 3; i++) base[i] = best[i];
+        }
+
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(13) << best[0] << std::setw(9) << base[0] / best[0]
+                  << std::setw(10) << best[1] << std::setw(9) << base[1] / best[1]
+                  << std::setw(12) << best[2] << std::setw(9) << base[2] / best[2] << std::endl;
+    }
+
+    return 0;
+}
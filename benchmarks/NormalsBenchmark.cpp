@@ -0,0 +1,130 @@
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Utils/NormalsGenerator/NormalsGenerator.h>
+
+#include "BenchmarkUtils.h"
+
+/// Generates normals of 2M and 10M triangle height field grids.
+/// Compares NormalsGenerator with previous map based implementation on the smaller grid.
+
+namespace {
+
+    void buildGrid(Mesh & mesh, const unsigned int & size) {
+        mesh.vertices.reserve(static_cast<size_t>(size + 1) * (size + 1) * 3);
+        mesh.indices.reserve(static_cast<size_t>(size) * size * 6);
+
+        for (unsigned int z = 0; z <= size; z++) {
+            for (unsigned int x = 0; x <= size; x++) {
+                float u = static_cast<float>(x) / size;
+                float v = static_cast<float>(z) / size;
+
+                mesh.vertices.insert(mesh.vertices.end(), { u * 100.0f, std::sin(u * 20.0f) * std::cos(v * 20.0f), v * 100.0f });
+            }
+        }
+
+        for (unsigned int z = 0; z < size; z++) {
+            for (unsigned int x = 0; x < size; x++) {
+                unsigned int a = z * (size + 1) + x;
+                unsigned int b = a + 1;
+                unsigned int c = a + size + 2;
+                unsigned int d = a + size + 1;
+
+                mesh.indices.insert(mesh.indices.end(), { a, d, c, a, c, b });
+            }
+        }
+    }
+
+    struct TriangleInfo {
+        float angle;
+        glm::vec3 normal;
+    };
+
+    /// Previous approach - copies of mesh data, vector of triangles per vertex in ordered map
+    void generatePrevious(Mesh * mesh) {
+        std::map<unsigned int, std::vector<TriangleInfo>> vertexToTriangles;
+
+        std::vector<TriangleInfo> triangles;
+
+        auto vertices = mesh->vertices;
+
+        for (unsigned int vertexId = 0; vertexId < vertices.size() / 3; vertexId++) {
+            vertexToTriangles.insert(std::pair<int, std::vector<TriangleInfo>>(vertexId, triangles));
+        }
+
+        auto indices = mesh->indices;
+
+        for (unsigned int j = 0; j < indices.size() / 3; j++) {
+            unsigned int v1 = indices[j * 3];
+            unsigned int v2 = indices[j * 3 + 1];
+            unsigned int v3 = indices[j * 3 + 2];
+
+            glm::vec3 v_1 = glm::vec3(vertices[v1 * 3], vertices[v1 * 3 + 1], vertices[v1 * 3 + 2]);
+            glm::vec3 v_2 = glm::vec3(vertices[v2 * 3], vertices[v2 * 3 + 1], vertices[v2 * 3 + 2]);
+            glm::vec3 v_3 = glm::vec3(vertices[v3 * 3], vertices[v3 * 3 + 1], vertices[v3 * 3 + 2]);
+
+            glm::vec3 a = v_2 - v_1;
+            glm::vec3 b = v_3 - v_1;
+
+            TriangleInfo info{};
+            info.angle = std::acos(dot(a, b) / (length(a) * length(b)));
+            info.normal = normalize(cross(a, b));
+
+            vertexToTriangles.at(v1).emplace_back(info);
+            vertexToTriangles.at(v2).emplace_back(info);
+            vertexToTriangles.at(v3).emplace_back(info);
+        }
+
+        for (auto & pair : vertexToTriangles) {
+            std::vector<TriangleInfo> triangleInfos = pair.second;
+
+            glm::vec3 weightedSum = glm::vec3(0.0, 0.0, 0.0);
+
+            for (auto & info : triangleInfos) {
+                weightedSum += info.normal * info.angle;
+            }
+
+            weightedSum /= triangleInfos.size();
+
+            mesh->normals.insert(mesh->normals.end(), {weightedSum.x, weightedSum.y, weightedSum.z});
+        }
+    }
+
+    double measure(Mesh & mesh, const int & repetitions) {
+        double best = 1e30;
+
+        for (int r = 0; r < repetitions; r++) {
+            mesh.normals.clear();
+
+            auto start = Clock::now();
+            NormalsGenerator::generate(&mesh);
+            best = std::min(best, milliseconds(start));
+        }
+
+        return best;
+    }
+}
+
+int main() {
+    std::cout << "Normals (" << JobSystem::Instance().getWorkerCount() << " workers)" << std::endl;
+
+    Mesh small;
+    buildGrid(small, 1000);
+
+    Mesh large;
+    buildGrid(large, 2237);
+
+    report("2M triangles", measure(small, 5), 28);
+    report("10M triangles", measure(large, 3), 28);
+
+    small.normals.clear();
+
+    auto start = Clock::now();
+    generatePrevious(&small);
+    report("2M triangles (previous)", milliseconds(start), 28);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <tinyobj/tiny_obj_loader.h>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Rendering/Mesh/ObjParser/ObjParser.h>
+
+#include "BenchmarkUtils.h"
+
+/// Parses bundled models and generated large grid model with tinyobj and with ObjParser.
+/// Run from build directory, models are read from ../resources/models.
+
+namespace {
+
+    /// Grid with normals and texcoords, quads as faces
+    void writeGrid(const std::string & path, const int & size) {
+        std::ofstream file(path);
+
+        file << std::fixed << std::setprecision(6);
+
+        for (int z = 0; z <= size; z++) {
+            for (int x = 0; x <= size; x++) {
+                float u = static_cast<float>(x) / size;
+                float v = static_cast<float>(z) / size;
+
+                file << "v " << u * 100.0f - 50.0f << " " << (u * v) * 3.0f << " " << v * 100.0f - 50.0f << "\n";
+                file << "vn 0.000000 1.000000 0.000000\n";
+                file << "vt " << u << " " << v << "\n";
+            }
+        }
+
+        for (int z = 0; z < size; z++) {
+            for (int x = 0; x < size; x++) {
+                int a = z * (size + 1) + x + 1;
+                int b = a + 1;
+                int c = a + size + 2;
+                int d = a + size + 1;
+
+                file << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " "
+                     << c << "/" << c << "/" << c << " " << d << "/" << d << "/" << d << "\n";
+            }
+        }
+    }
+
+    void compare(const std::string & path, const int & repetitions) {
+        double size = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+        double bestTinyobj = 1e30;
+        double bestParser = 1e30;
+
+        size_t tinyobjTriangles = 0;
+        size_t parserTriangles = 0;
+
+        for (int r = 0; r < repetitions; r++) {
+            auto start = Clock::now();
+
+            tinyobj::attrib_t attrib;
+            std::vector<tinyobj::shape_t> shapes;
+            std::vector<tinyobj::material_t> materials;
+            std::string warning;
+            std::string error;
+
+            tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, path.c_str());
+
+            bestTinyobj = std::min(bestTinyobj, milliseconds(start));
+
+            tinyobjTriangles = 0;
+
+            for (auto & shape : shapes) {
+                tinyobjTriangles += shape.mesh.indices.size() / 3;
+            }
+
+            start = Clock::now();
+
+            ObjData data;
+            ObjParser::parse(path, data);
+
+            bestParser = std::min(bestParser, milliseconds(start));
+
+            parserTriangles = data.indices.size() / 3;
+        }
+
+        std::cout << "  " << std::setw(28) << std::left << std::filesystem::path(path).filename().string() << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(8) << size << " MB"
+                  << std::setprecision(3)
+                  << std::setw(12) << bestTinyobj << " ms"
+                  << std::setw(12) << bestParser << " ms"
+                  << std::setprecision(1)
+                  << std::setw(10) << size / (bestParser / 1000.0) << " MB/s"
+                  << std::setw(8) << bestTinyobj / bestParser << "x";
+
+        if (tinyobjTriangles != parserTriangles) {
+            std::cout << "  triangle count differs: " << tinyobjTriangles << " vs " << parserTriangles;
+        }
+
+        std::cout << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "OBJ parsing (" << JobSystem::Instance().getWorkerCount() << " workers), tinyobj vs ObjParser" << std::endl;
+
+    std::vector<std::string> paths;
+
+    for (auto & entry : std::filesystem::directory_iterator("../resources/models")) {
+        if (entry.path().extension() == ".obj") {
+            paths.push_back(entry.path().string());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+
+    for (auto & path : paths) {
+        compare(path, 10);
+    }
+
+    std::string gridPath = "obj_parser_benchmark_grid.obj";
+
+    writeGrid(gridPath, 1000);
+    compare(gridPath, 3);
+    std::remove(gridPath.c_str());
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Scene/GameObjectFactory/GameObjectFactory.h>
+#include <Scene/SceneFile/SceneFile.h>
+#include <Utils/MappedFile/MappedFile.h>
+
+#include "BenchmarkUtils.h"
+
+/// Saves 1M cube scene into binary scene file and loads it back.
+/// Compares loading with building the same scene in code and with only paging the file in.
+
+namespace {
+
+    std::shared_ptr<Scene> buildScene(const size_t & count) {
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        auto scene = std::make_shared<Scene>();
+
+        GameObjectFactory::reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+            float r = unit(random);
+            float g = unit(random);
+            float b = unit(random);
+
+            scene->addChild(GameObjectFactory::cube(glm::vec3(r * 400.0f, g * 400.0f, b * 400.0f), glm::vec3(r, g, b),
+                                                    glm::vec3(0.1f), glm::vec4(r, g, b, 1.0f)));
+        }
+
+        return scene;
+    }
+}
+
+int main() {
+    const size_t count = 1000000;
+    const char * path = "scene_benchmark.scene";
+
+    std::cout << "Scene file (" << count << " objects)" << std::endl;
+
+    auto start = Clock::now();
+    auto scene = buildScene(count);
+    report("build in code", milliseconds(start));
+
+    start = Clock::now();
+    SceneFile::save(*scene, path);
+    report("save", milliseconds(start));
+
+    scene.reset();
+
+    /// Lower bound - map file and touch every page
+    start = Clock::now();
+    {
+        MappedFile file(path);
+
+        size_t sum = 0;
+
+        for (size_t i = 0; i < file.getSize(); i += 4096) {
+            sum += file.getData()[i];
+        }
+
+        std::cout << "  mapped " << file.getSize() / (1024 * 1024) << " MB (" << sum % 10 << ")" << std::endl;
+    }
+    report("page in", milliseconds(start));
+
+    start = Clock::now();
+    auto loaded = SceneFile::load(path);
+    report("load", milliseconds(start));
+
+    std::cout << "  loaded " << (loaded ? loaded->children.size() : 0) << " objects" << std::endl;
+
+    std::remove(path);
+
+    return 0;
+}
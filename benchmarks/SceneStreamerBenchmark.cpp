@@ -0,0 +1,151 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <Components/Behaviour/RotatorComponent/Rotator.h>
+#include <Rendering/Culling/SceneCuller/SceneCuller.h>
+#include <Rendering/RenderingManager/RenderingManager.h>
+#include <Scene/CommandQueue/CommandQueue.h>
+#include <Scene/SceneStreamer/SceneStreamer.h>
+
+#include "BenchmarkUtils.h"
+
+/// Streams a world of cube cells in and out while viewer flies over it. Commands are applied the way
+/// EngineRenderer::applyCommands does, without GL. After full stream-out every streamed object has to be
+/// released - World entity count must return to its baseline - and their meshes once their infos are empty
+/// for RenderingManager::EMPTY_INFO_FRAMES frames.
+
+namespace {
+
+    /// World is a strip of cells along X, cells outside of it are empty
+    const int32_t worldCells = 40;
+
+    std::vector<CellObject> generateCell(const CellCoord & coord, const float & cellSize, const int & side) {
+        std::vector<CellObject> objects;
+
+        if (coord.x < 0 || coord.x >= worldCells) return objects;
+
+        objects.reserve(side * side);
+
+        for (int x = 0; x < side; x++) {
+            for (int z = 0; z < side; z++) {
+                CellObject object;
+                object.position = glm::vec3((static_cast<float>(coord.x) + (x + 0.5f) / side) * cellSize, 0.0f,
+                                            (static_cast<float>(coord.z) + (z + 0.5f) / side) * cellSize);
+
+                object.mesh = std::make_shared<MeshComponent>(CUBE);
+
+                object.renderer = std::make_shared<MeshRenderer>();
+                object.renderer->instanced = true;
+                object.renderer->frustumCulling = true;
+
+                /// Bounding boxes and behaviours refer back to their objects
+                object.renderer->enableBoundingBox = (x + z) % 4 == 0;
+
+                if ((x + z) % 8 == 0) {
+                    object.setup = [](GameObject & gameObject) {
+                        gameObject.addComponent(std::make_shared<Rotator>());
+                    };
+                }
+
+                objects.push_back(std::move(object));
+            }
+        }
+
+        return objects;
+    }
+
+    /// Spawned objects are registered in rendering manager and culler, destroyed ones removed from both
+    void applyCommands(RenderingManager & manager, SceneCuller & culler) {
+        std::vector<std::shared_ptr<RenderInfo>> createdInfos;
+
+        for (auto & commands : CommandQueue::Instance().drain()) {
+            for (auto & command : commands) {
+                auto & object = command.object;
+
+                if (command.type == CommandBuffer::Command::Type::SPAWN && !manager.contains(object.get())) {
+                    if (auto info = manager.addObject(object, createdInfos)) {
+                        culler.add(info, object.get());
+                    }
+                }
+                else if (command.type == CommandBuffer::Command::Type::DESTROY && manager.contains(object.get())) {
+                    culler.remove(object.get());
+                    manager.removeObject(object);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    const float cellSize = 32.0f;
+    const int side = 16;
+    const int frames = 600;
+
+    auto & world = World::Instance();
+    size_t baseline = world.count<Transform>();
+
+    RenderingManager manager;
+    SceneCuller culler;
+
+    size_t peakObjects = 0;
+    double worstFrame = 0.0;
+
+    auto start = Clock::now();
+
+    {
+        SceneStreamer streamer(cellSize, 96.0f, 128.0f, [cellSize, side](const CellCoord & coord) {
+            return generateCell(coord, cellSize, side);
+        });
+
+        streamer.setSpawnBudget(4000);
+
+        std::cout << "Scene streamer (" << side * side << " objects per cell, " << frames << " frames)" << std::endl;
+
+        for (int frame = 0; frame < frames; frame++) {
+            auto frameStart = Clock::now();
+
+            streamer.update(glm::vec3(static_cast<float>(frame) * 2.0f, 0.0f, 0.0f));
+            applyCommands(manager, culler);
+            manager.releaseEmptyInfos();
+
+            worstFrame = std::max(worstFrame, milliseconds(frameStart));
+            peakObjects = std::max(peakObjects, culler.getRenderableCount());
+        }
+
+        /// Viewer leaves the world, all cells are unloaded and only empty ones are loaded
+        streamer.update(glm::vec3(-1e6f, 0.0f, 0.0f));
+        applyCommands(manager, culler);
+    }
+
+    /// First call only notices info is empty
+    for (uint64_t frame = 0; frame <= RenderingManager::EMPTY_INFO_FRAMES; frame++) {
+        manager.releaseEmptyInfos();
+    }
+
+    report("total", milliseconds(start));
+    report("worst frame", worstFrame);
+
+    std::cout << "  peak " << peakObjects << " objects" << std::endl;
+
+    size_t leaked = world.count<Transform>() - baseline;
+
+    if (leaked > 0) {
+        std::cout << "  " << leaked << " streamed out entities were not released" << std::endl;
+        return 1;
+    }
+
+    std::cout << "  all streamed out entities released" << std::endl;
+
+    /// Only bounding box info stays
+    size_t meshInfos = manager.instancedRenderInfos.size() - manager.instancedRenderInfos.count("bbox");
+
+    if (meshInfos > 0) {
+        std::cout << "  " << meshInfos << " render infos of streamed out meshes were not released" << std::endl;
+        return 1;
+    }
+
+    std::cout << "  all render infos of streamed out meshes released" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Engine/EngineInternal/Scene/Transform.h>
+
+#include "BenchmarkUtils.h"
+
+/// Moves and spins 100k transforms and computes their interpolated matrices every frame.
+/// Compares batched TransformStorage pass against matrices built per object from euler angles.
+
+int main() {
+    const size_t count = 100000;
+    const int repetitions = 20;
+    const float deltaTime = 1.0f / 60.0f;
+
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+
+    std::vector<glm::mat4x4> matrices(count);
+    std::vector<std::unique_ptr<Transform>> transforms;
+
+    std::vector<glm::vec3> positions(count);
+    std::vector<glm::vec3> rotations(count);
+    std::vector<glm::vec3> velocities(count);
+
+    for (size_t i = 0; i < count; i++) {
+        positions[i] = glm::vec3(position(random), position(random), position(random));
+        velocities[i] = glm::vec3(speed(random), speed(random), speed(random));
+
+        transforms.push_back(std::make_unique<Transform>());
+        transforms[i]->setPosition(positions[i]);
+        transforms[i]->setAngularVelocity(velocities[i]);
+        transforms[i]->setMatrixTarget(&matrices, static_cast<int>(i));
+        transforms[i]->storePrevious();
+    }
+
+    auto & storage = TransformStorage::Instance();
+
+    std::cout << "Transforms (" << count << " moving, " << JobSystem::Instance().getWorkerCount() << " workers)" << std::endl;
+
+    double bestTick = 1e30;
+    double bestMatrices = 1e30;
+
+    for (int r = 0; r < repetitions; r++) {
+        auto start = Clock::now();
+
+        storage.storePrevious();
+
+        for (size_t i = 0; i < count; i++) {
+            positions[i].y += deltaTime;
+            transforms[i]->setPosition(positions[i]);
+        }
+
+        storage.integrateAngularVelocity(deltaTime);
+
+        bestTick = std::min(bestTick, milliseconds(start));
+
+        start = Clock::now();
+
+        storage.clearVisible();
+
+        for (auto & transform : transforms) {
+            transform->markVisible();
+        }
+
+        storage.computeMatrices(0.5f);
+
+        bestMatrices = std::min(bestMatrices, milliseconds(start));
+    }
+
+    report("tick (soa)", bestTick);
+    report("matrices (soa)", bestMatrices);
+
+    /// Previous approach - euler angles integrated per object, six trig calls and matrix per object
+    double bestPerObject = 1e30;
+
+    for (int r = 0; r < repetitions; r++) {
+        auto start = Clock::now();
+
+        for (size_t i = 0; i < count; i++) {
+            glm::vec3 previous = rotations[i];
+            rotations[i] += velocities[i] * deltaTime;
+
+            matrices[i] = MatrixUtils::modelMatrix(glm::vec3(1.0f), positions[i],
+                                                   MatrixUtils::rotationMatrix(glm::mix(previous, rotations[i], 0.5f)));
+        }
+
+        bestPerObject = std::min(bestPerObject, milliseconds(start));
+    }
+
+    report("tick + matrices (euler)", bestPerObject);
+
+    std::cout << "  computed " << storage.getLastComputedCount() << " matrices per frame" << std::endl;
+
+    return 0;
+}
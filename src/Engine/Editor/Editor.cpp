@@ -1,5 +1,7 @@
 #include "Editor.h"
 
+#include <Engine/EngineInternal/Time.h>
+
 Editor::Editor(const std::shared_ptr<Window> & window) {
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -75,6 +77,9 @@ void Editor::DockSpaceBegin() {
         ImGui::DockBuilderDockWindow("Scene1", scene1);
         ImGui::DockBuilderDockWindow("Scene2", scene2);
         ImGui::DockBuilderDockWindow("Settings", settings);
+        ImGui::DockBuilderDockWindow("Profiler", settings);
+        ImGui::DockBuilderDockWindow("Memory", settings);
+        ImGui::DockBuilderDockWindow("Timeline", dock_main_id);
 
         ImGui::DockBuilderFinish(dock_main_id);
     }
@@ -103,6 +108,10 @@ void Editor::renderSettingsWindow() {
     ImGui::Dummy(ImVec2(0.0f, 10.0f));
     ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
 
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+    ImGui::Text("%.0f Hz simulation, %llu dropped ticks", 1.0 / Time::Instance().fixedDeltaTime,
+                static_cast<unsigned long long>(Time::Instance().droppedTicks.load()));
+
     ImGui::Dummy(ImVec2(0.0f, 10.0f));
     ImGui::Text("Enable bounding boxes:");
     ImGui::Dummy(ImVec2(0.0f, 10.0f));
@@ -117,6 +126,11 @@ void Editor::renderSettingsWindow() {
     ImGui::Text("Show normals:");
     ImGui::Dummy(ImVec2(0.0f, 10.0f));
     ToggleButton("id3", Settings::Instance().showNormalsProperty);
+
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+    ImGui::Text("Pipelined frames:");
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+    ToggleButton("id4", Settings::Instance().pipelinedFramesProperty);
     ImGui::End();
 }
 
@@ -125,6 +139,174 @@ void Editor::renderInfoWindow() {
     ImGui::End();
 }
 
+void Editor::renderProfilerWindow() {
+    auto & profiler = GpuProfiler::Instance();
+
+    ImGui::Begin("Profiler");
+
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+    ImGui::Text("GPU frame: %llu", profiler.getResolvedFrameIndex());
+    ImGui::Text("Dropped results: %llu", profiler.getDroppedFrames());
+
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+
+    if (ImGui::Button("Dump GPU timings")) {
+        profiler.dump("gpu_profile.json");
+    }
+
+    auto & histories = profiler.getHistories();
+
+    for (auto & result : profiler.getLastResults()) {
+        auto & history = histories.at(result.name);
+
+        ImGui::Dummy(ImVec2(0.0f, 10.0f));
+        ImGui::Indent(10.0f * result.depth + 1.0f);
+        ImGui::Text("%s: %.3f ms (avg %.3f, max %.3f)", result.name.c_str(), history.last, history.average, history.max);
+        ImGui::PlotLines(("##" + result.name).c_str(), history.samples.data(), history.count, history.count < GpuZoneHistory::SIZE ? 0 : history.offset,
+                         nullptr, 0.0f, history.max * 1.2f, ImVec2(ImGui::GetContentRegionAvail().x, 40.0f));
+        ImGui::Unindent(10.0f * result.depth + 1.0f);
+    }
+
+    ImGui::End();
+}
+
+void Editor::renderTimelineWindow() {
+    auto & profiler = CpuProfiler::Instance();
+
+    ImGui::Begin("Timeline");
+
+    if (ImGui::Button(timelinePaused ? "Resume" : "Pause")) {
+        timelinePaused = !timelinePaused;
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Export Chrome trace")) {
+        profiler.exportChromeTrace("cpu_trace.json");
+    }
+
+    if (!timelinePaused && profiler.getLastFrameEnd() != timelineFrameEnd) {
+        timelineFrameStart = profiler.getLastFrameStart();
+        timelineFrameEnd = profiler.getLastFrameEnd();
+        timelineEvents.clear();
+        profiler.collect(timelineFrameStart, timelineFrameEnd, timelineEvents);
+    }
+
+    auto frameDuration = static_cast<double>(timelineFrameEnd - timelineFrameStart);
+
+    ImGui::SameLine();
+    ImGui::Text("CPU frame: %.3f ms", frameDuration / 1000000.0);
+
+    if (frameDuration <= 0.0) {
+        ImGui::End();
+        return;
+    }
+
+    auto threadNames = profiler.getThreadNames();
+
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const float labelWidth = 100.0f;
+
+    ImDrawList * drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+
+    /// Lay out threads one under another, each using as many rows as its deepest zone
+    std::vector<uint32_t> threadDepths(threadNames.size(), 0);
+
+    for (auto & event : timelineEvents) {
+        threadDepths[event.threadIndex] = std::max(threadDepths[event.threadIndex], event.depth + 1);
+    }
+
+    std::vector<float> threadOffsets(threadNames.size(), 0.0f);
+    float totalHeight = 0.0f;
+
+    for (size_t i = 0; i < threadNames.size(); i++) {
+        threadOffsets[i] = totalHeight;
+        drawList->AddText(ImVec2(origin.x, origin.y + totalHeight), IM_COL32(200, 200, 200, 255), threadNames[i].c_str());
+        totalHeight += rowHeight * std::max(threadDepths[i], 1u);
+    }
+
+    for (auto & event : timelineEvents) {
+        double start = std::max(static_cast<double>(event.start), static_cast<double>(timelineFrameStart)) - timelineFrameStart;
+        double end = std::min(static_cast<double>(event.end), static_cast<double>(timelineFrameEnd)) - timelineFrameStart;
+
+        ImVec2 min(origin.x + labelWidth + static_cast<float>(start / frameDuration) * width,
+                   origin.y + threadOffsets[event.threadIndex] + event.depth * rowHeight);
+        ImVec2 max(std::max(origin.x + labelWidth + static_cast<float>(end / frameDuration) * width, min.x + 1.0f),
+                   min.y + rowHeight - 1.0f);
+
+        ImU32 color = IM_COL32(60 + (event.depth * 40) % 160, 110, 200 - (event.depth * 30) % 120, 255);
+
+        drawList->AddRectFilled(min, max, color);
+
+        if (max.x - min.x > ImGui::CalcTextSize(event.name).x + 4.0f) {
+            drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(255, 255, 255, 255), event.name);
+        }
+
+        if (ImGui::IsMouseHoveringRect(min, max)) {
+            ImGui::SetTooltip("%s: %.3f ms", event.name, static_cast<double>(event.end - event.start) / 1000000.0);
+        }
+    }
+
+    ImGui::Dummy(ImVec2(labelWidth + width, totalHeight));
+
+    ImGui::End();
+}
+
+void Editor::renderMemoryWindow() {
+    auto & tracker = MemoryTracker::Instance();
+
+    ImGui::Begin("Memory");
+
+    if (ImGui::Button("Dump memory usage")) {
+        tracker.dump("memory_usage.json");
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Reset peaks")) {
+        tracker.resetPeaks();
+    }
+
+    const double megabyte = 1024.0 * 1024.0;
+
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+    ImGui::Text("CPU: %.2f MB", tracker.getTotal(false) / megabyte);
+    ImGui::Text("GPU: %.2f MB", tracker.getTotal(true) / megabyte);
+    ImGui::Dummy(ImVec2(0.0f, 10.0f));
+
+    ImGui::Columns(4, "MemoryCategories");
+    ImGui::Separator();
+    ImGui::Text("Category");
+    ImGui::NextColumn();
+    ImGui::Text("MB");
+    ImGui::NextColumn();
+    ImGui::Text("Peak MB");
+    ImGui::NextColumn();
+    ImGui::Text("Allocations");
+    ImGui::NextColumn();
+    ImGui::Separator();
+
+    for (int i = 0; i < static_cast<int>(MemoryCategory::COUNT); i++) {
+        auto category = static_cast<MemoryCategory>(i);
+        auto stats = tracker.getStats(category);
+
+        ImGui::Text("%s", MemoryTracker::name(category));
+        ImGui::NextColumn();
+        ImGui::Text("%.2f", stats.current / megabyte);
+        ImGui::NextColumn();
+        ImGui::Text("%.2f", stats.peak / megabyte);
+        ImGui::NextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocations));
+        ImGui::NextColumn();
+    }
+
+    ImGui::Columns(1);
+
+    ImGui::End();
+}
+
 void Editor::ToggleButton(const char * str_id, const std::shared_ptr<Observable<bool>> & property) {
     ImVec2 p = ImGui::GetCursorScreenPos();
     ImDrawList * draw_list = ImGui::GetWindowDrawList();
@@ -202,6 +384,9 @@ void Editor::renderFrame(std::shared_ptr<Window> & window, double widths[], doub
     Editor::renderSceneWindow("Scene1", widths[0], heights[0], textures[0], Editor::on_scene_left_resize);
     Editor::renderSceneWindow("Scene2", widths[1], heights[1], textures[1], Editor::on_scene_right_resize);
     Editor::renderSettingsWindow();
+    Editor::renderProfilerWindow();
+    Editor::renderTimelineWindow();
+    Editor::renderMemoryWindow();
 
     Editor::DockSpaceEnd();
 
@@ -12,6 +12,9 @@
 #include <glm/glm/glm.hpp>
 #include <rose/cpp/src/Rose/Property/BooleanProperty.h>
 #include <Engine/EngineInternal/Settings.h>
+#include <Engine/EngineInternal/Profiling/GpuProfiler/GpuProfiler.h>
+#include <Engine/EngineInternal/Profiling/CpuProfiler/CpuProfiler.h>
+#include <Engine/EngineInternal/Profiling/MemoryTracker/MemoryTracker.h>
 #include "EditorStyle.h"
 
 #include "../Window/Window.h"
@@ -22,6 +25,13 @@ class Editor {
         
         ImGuiIO * io_ptr;
 
+        bool timelinePaused = false;
+
+        uint64_t timelineFrameStart = 0;
+        uint64_t timelineFrameEnd = 0;
+
+        std::vector<CpuProfileEvent> timelineEvents;
+
     public:
         
         std::shared_ptr<Observable<glm::vec2>> sceneLeftSizeProperty;
@@ -44,6 +54,12 @@ class Editor {
         
         void renderInfoWindow();
 
+        void renderProfilerWindow();
+
+        void renderTimelineWindow();
+
+        void renderMemoryWindow();
+
         void renderSceneWindow(const std::string & name, float texWidth, float texHeight, GLuint texture, ImGuiSizeCallback custom_callback = NULL);
 
         void ToggleButton(const char * str_id, const std::shared_ptr<Observable<bool>> & property);
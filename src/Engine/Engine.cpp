@@ -2,8 +2,18 @@
 #include "Engine.h"
 
 #include "Scene/BaseEngineScene.h"
+#include "EngineInternal/Time.h"
+
+#include <Profiling/GpuProfiler/GpuProfiler.h>
+#include <Profiling/Profile.h>
 
 Engine::Engine() {
+    PROFILE_THREAD("Main");
+    PROFILE_SCOPE("Engine::Engine");
+
+    /// Job system binds main thread to the thread which creates it
+    JobSystem::Instance();
+
     window = std::make_shared<Window>(1500, 1000);
 
     physicsEngine = std::make_shared<PhysicsEngine>();
@@ -18,6 +28,8 @@ Engine::Engine() {
 
     editor = std::make_unique<Editor>(window);
 
+    framePipeline = std::make_unique<FramePipeline>();
+
     onSceneLeftSizeChanged = createObserver<glm::vec2>([&](glm::vec2 v) { engineRenderer->setTargetSize(v, 0); });
     onSceneRightSizeChanged = createObserver<glm::vec2>([&](glm::vec2 v) { engineRenderer->setTargetSize(v, 1); });
     onBoundingBoxesEnablementChanged = createObserver<bool>([&](bool v) { engineRenderer->setBoundingBoxesEnabled(v); });
@@ -35,29 +47,142 @@ void Engine::addScene(const std::shared_ptr<Scene> & scene) {
     engineRenderer->addScene(scene);
 }
 
+void Engine::addStreamedScene(const std::shared_ptr<SceneStreamer> & streamer) {
+    streamers.push_back(streamer);
+}
+
+void Engine::spawn(const std::shared_ptr<GameObject> & object) {
+    CommandBuffer commands;
+    commands.spawn(object);
+    commands.submit();
+}
+
+void Engine::spawn(std::function<std::shared_ptr<GameObject>()> create) {
+    CommandBuffer commands;
+    commands.spawn(std::move(create));
+    commands.submit();
+}
+
+void Engine::despawn(const std::shared_ptr<GameObject> & object) {
+    CommandBuffer commands;
+    commands.destroy(object);
+    commands.submit();
+}
+
 void Engine::prepareScenes() {
+    PROFILE_FUNCTION();
     engineRenderer->prepare();
 }
 
+void Engine::simulate() {
+    PROFILE_FUNCTION();
+
+    auto & time = Time::Instance();
+
+    physicsEngine->step(time.getFixedDeltaTime());
+    engineRenderer->tick();
+
+    time.endTick();
+}
+
+void Engine::prepareFrame(const double & frameTime, const FrustumPlanes & frustum) {
+    PROFILE_FUNCTION();
+
+    auto & time = Time::Instance();
+
+    /// Simulation runs in fixed steps, independently of how long rendering takes
+    int steps = time.advance(frameTime);
+
+    for (int i = 0; i < steps; i++) {
+        simulate();
+    }
+
+    time.updateInterpolation();
+
+    engineRenderer->prepareFrame(frustum);
+}
+
 void Engine::start() {
     prepareScenes();
 
+    auto & time = Time::Instance();
+
+    lastFrame = glfwGetTime();
+
     while (window->shouldBeOpened()) {
+        PROFILE_FRAME();
+        PROFILE_SCOPE("Frame");
 
         currentFrame = glfwGetTime();
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        //physicsEngine->step(deltaTime);
+        GpuProfiler::Instance().beginFrame();
+
+        /// Background work reads Time and scene state, wait for it before touching them
+        framePipeline->wait();
+
+        /// Streamed cells are instantiated while no frame is being prepared, spawned by commands below
+        for (auto & streamer : streamers) {
+            streamer->update(engineRenderer->perspectiveCameras[0]->getPosition());
+        }
+
+        /// Commands recorded during last frame (spawns, transforms, fields) are applied before next one is prepared
+        engineRenderer->applyCommands();
+
+        /// Models finished loading on workers replace their placeholders
+        engineRenderer->uploadLoadedMeshes();
+
+        /// Meshes no object used for a while free their buffers
+        engineRenderer->releaseEmptyInfos();
+
+        time.beginFrame(deltaTime);
+
+        engineRenderer->updateCameras();
+
+        FrustumPlanes frustum = engineRenderer->perspectiveCameras[0]->getFrustumPlanes();
+
+        if (Settings::Instance().getPipelinedFrames()) {
+            /// Show frame prepared in background during previous iteration and start preparing next one
+            engineRenderer->swapFrames();
+
+            double frameTime = deltaTime;
+
+            framePipeline->kick([this, frameTime, frustum]() { prepareFrame(frameTime, frustum); });
+        }
+        else {
+            prepareFrame(deltaTime, frustum);
+            engineRenderer->swapFrames();
+        }
+
         engineRenderer->renderFrame();
 
-        editor->renderFrame(window, engineRenderer->widths, engineRenderer->heights, engineRenderer->textures);
-        glfwSwapBuffers(window->window);
-        glfwPollEvents();
+        {
+            PROFILE_SCOPE("Editor");
+            GpuProfiler::Instance().beginZone("Editor");
+            editor->renderFrame(window, engineRenderer->widths, engineRenderer->heights, engineRenderer->textures);
+            GpuProfiler::Instance().endZone();
+        }
+
+        GpuProfiler::Instance().endFrame();
+
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(window->window);
+        }
+
+        {
+            PROFILE_SCOPE("PollEvents");
+            glfwPollEvents();
+        }
     }
 
+    framePipeline->wait();
+
     editor->terminate();
 
+    GpuProfiler::Instance().terminate();
+
     glfwTerminate();
 
     SC.unsubscribeAll();
@@ -5,6 +5,7 @@
 
 #include <Scene/GameObject/GameObject.h>
 #include <Scene/Scene.h>
+#include <Scene/SceneStreamer/SceneStreamer.h>
 
 #include "Engine/EngineInternal/Rendering/Camera/OrtographicCamera/OrtographicCamera.h"
 #include "Engine/EngineInternal/Rendering/Camera/PerspectiveCamera/PerspectiveCamera.h"
@@ -15,6 +16,7 @@
 #include "Engine/Editor/Editor.h"
 
 #include "Rendering/EngineRenderer/EngineRenderer.h"
+#include "FramePipeline/FramePipeline.h"
 
 class Engine {
 
@@ -23,6 +25,9 @@ class Engine {
         std::shared_ptr<Window> window;
         std::unique_ptr<Editor> editor;
         std::shared_ptr<PhysicsEngine> physicsEngine;
+        std::unique_ptr<FramePipeline> framePipeline;
+
+        std::vector<std::shared_ptr<SceneStreamer>> streamers;
 
         Observer<glm::vec2> onSceneLeftSizeChanged;
         Observer<glm::vec2> onSceneRightSizeChanged;
@@ -37,6 +42,11 @@ class Engine {
 
         void prepareScenes();
 
+        void simulate();
+
+        /// CPU side of the frame: fixed simulation ticks, culling and matrices
+        void prepareFrame(const double & frameTime, const FrustumPlanes & frustum);
+
     public:
 
         std::shared_ptr<EngineRenderer> engineRenderer;
@@ -46,4 +56,17 @@ class Engine {
         void start();
 
         void addScene(const std::shared_ptr<Scene> & scene);
+
+        /// Cells of streamed scene are loaded around main camera while engine runs
+        void addStreamedScene(const std::shared_ptr<SceneStreamer> & streamer);
+
+        /// Object is rendered from next frame, may be called from any thread, but object itself has to be
+        /// created on main thread. Many changes at once are cheaper recorded into CommandBuffer and submitted together.
+        void spawn(const std::shared_ptr<GameObject> & object);
+
+        /// Object returned by create is rendered from next frame. Create is called on main thread,
+        /// so this is how other threads spawn new objects.
+        void spawn(std::function<std::shared_ptr<GameObject>()> create);
+
+        void despawn(const std::shared_ptr<GameObject> & object);
 };
\ No newline at end of file
@@ -1,5 +1,15 @@
 #include "BehaviourComponent.h"
 
+#include <algorithm>
+
 void BehaviourComponent::SetObject(GameObjectBase * parentObject) {
     gameObject = parentObject;
-}
\ No newline at end of file
+}
+
+void BehaviourComponent::startCoroutine(Task task) {
+    tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const Task & t) { return t.done(); }), tasks.end());
+
+    if (!task.done()) {
+        tasks.push_back(std::move(task));
+    }
+}
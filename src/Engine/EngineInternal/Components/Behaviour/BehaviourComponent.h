@@ -1,12 +1,31 @@
 #pragma once
 
+#include <vector>
+
+#include <Coroutines/TaskScheduler/TaskScheduler.h>
 #include <Scene/GameObject/GameObjectBase.h>
 
+/// Behaviour either overrides Update, which is called every simulation tick, or starts coroutines in Start
+/// and sleeps between their co_awaits. Start is called once before first tick after the behaviour was added.
 class BehaviourComponent : public Component {
 
+    protected:
+
+        /// Coroutines owned by this behaviour, destroyed together with it
+        std::vector<Task> tasks;
+
+        void startCoroutine(Task task);
+
     public:
         GameObjectBase * gameObject = nullptr;
 
+        /// Component types Update reads and writes on its own object (Transform for its transform).
+        /// SystemScheduler runs behaviour types with disjoint access in parallel. Behaviour which does not
+        /// declare access may touch anything - it runs alone, one object after another.
+        static ComponentMask reads() { return ALL_COMPONENTS; }
+
+        static ComponentMask writes() { return ALL_COMPONENTS; }
+
         void Start() override {
 
         }
@@ -1,9 +0,0 @@
-#include "Rigidbody.h"
-
-void Rigidbody::Start() {
-    BehaviourComponent::Start();
-}
-
-void Rigidbody::Update() {
-    BehaviourComponent::Update();
-}
@@ -9,7 +9,5 @@ class Rigidbody : public BehaviourComponent {
         float mass = 1.0f;
         float restitution = 1.0f;
 
-        void Start() override;
-
-        void Update() override;
+        /// Simulated by PhysicsEngine, no per tick update
 };
\ No newline at end of file
@@ -1,18 +1,24 @@
 #include "Rotator.h"
 
 void Rotator::Start() {
-    timer.reset();
+    startCoroutine(spin());
 }
 
-void Rotator::Update() {
-    if (timer.elapsed() >= 17) {
-        timer.reset();
-        auto t = gameObject->transform;
-        auto oldRotation = t.rotation;
-        auto oldPos = t.position;
+Task Rotator::spin() {
+    using namespace std::chrono_literals;
 
-        gameObject->transform.dirty = false;
-        gameObject->transform.rotation = glm::vec3(oldRotation.x + 0.05, oldRotation.y + 0.05, oldRotation.z + 0.05);
-        gameObject->transform.dirty = true;
+    glm::vec3 applied = speed;
+    gameObject->transform().setAngularVelocity(applied);
+
+    /// Rotators started together are spread over the period, so their checks do not all land in one tick
+    co_await waitTicks(gameObject->entity.index % TaskScheduler::ticksFor(250ms));
+
+    while (true) {
+        if (speed != applied) {
+            applied = speed;
+            gameObject->transform().setAngularVelocity(applied);
+        }
+
+        co_await wait(250ms);
     }
-}
\ No newline at end of file
+}
@@ -1,17 +1,18 @@
 #pragma once
 
-#include <Engine/EngineInternal/Utils/Timer.h>
 #include "../BehaviourComponent.h"
 
 class Rotator : public BehaviourComponent {
 
-    private:
-
-        int a = 0;
+    public:
 
-        Timer timer;
+        /// Angular velocity in radians per second
+        glm::vec3 speed = glm::vec3(3.0f);
 
-    public:
         void Start() override;
-        void Update() override;
+
+    private:
+
+        /// Orientation is integrated by TransformStorage, coroutine only wakes up to apply changed speed
+        Task spin();
 };
\ No newline at end of file
@@ -6,15 +6,28 @@
 #include "../Component.h"
 #include "../../Rendering/Shading/ShaderType.h"
 #include "../../Rendering/Mesh/MeshType.h"
+#include "../../Rendering/Mesh/MeshResidency.h"
+
+class Mesh;
 
 class MeshComponent : public Component {
 
     public:
 
+        /// Surface and line meshes share one column, it holds first mesh of the object
+        typedef MeshComponent Kind;
+
         MeshType meshType = NONE;
 
         std::string path;
 
+        /// Applied to mesh built from this component (see Mesh::residency)
+        MeshResidency residency = MeshResidency::DISCARD;
+
+        /// Mesh built in advance (e.g. by streaming worker), used instead of building one on registration.
+        /// It outlives removal of the object, geometry released after upload is built again when object is spawned back.
+        std::shared_ptr<Mesh> mesh;
+
         MeshComponent();
 
         MeshComponent(const MeshType & meshType);
@@ -2,6 +2,8 @@
 
 #include "MeshComponent.h"
 
+#include <Memory/ObjectPool/ObjectPool.h>
+
 class SurfaceMeshComponent : public MeshComponent {
     public:
         float width = 10.0;
@@ -10,6 +12,6 @@ class SurfaceMeshComponent : public MeshComponent {
         SurfaceMeshComponent() : MeshComponent(SURFACE) {}
 
         static std::shared_ptr<SurfaceMeshComponent> create() {
-            return std::make_shared<SurfaceMeshComponent>();
+            return makePooled<SurfaceMeshComponent>();
         }
 };
\ No newline at end of file
@@ -0,0 +1,16 @@
+#include "Task.h"
+
+#include <Coroutines/TaskScheduler/TaskScheduler.h>
+
+void Task::destroy() {
+    if (!handle) return;
+
+    int32_t waitId = handle.promise().waitId;
+
+    if (waitId >= 0) {
+        TaskScheduler::Instance().cancel(waitId);
+    }
+
+    handle.destroy();
+    handle = nullptr;
+}
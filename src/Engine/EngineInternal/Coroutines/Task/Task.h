@@ -0,0 +1,71 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+
+/// Owning handle of behaviour coroutine.
+///
+/// Coroutine starts running immediately and runs until its first co_await. Suspended coroutine is resumed
+/// by TaskScheduler on simulation thread once the awaited condition holds (see wait, nextTick, loaded).
+/// Destroying task cancels pending wait and frees coroutine frame.
+class Task {
+
+    public:
+
+        struct promise_type {
+            /// Entry in TaskScheduler while suspended, -1 when running or done
+            int32_t waitId = -1;
+
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+            std::suspend_never initial_suspend() noexcept { return {}; }
+
+            /// Frame is kept alive until Task is destroyed
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void() {}
+
+            void unhandled_exception() {
+                std::cerr << "Unhandled exception in behaviour coroutine" << std::endl;
+                std::terminate();
+            }
+        };
+
+        typedef std::coroutine_handle<promise_type> Handle;
+
+        Task() = default;
+
+        explicit Task(const Handle & coroutine) : handle(coroutine) {}
+
+        Task(const Task & other) = delete;
+
+        Task & operator=(const Task & other) = delete;
+
+        Task(Task && other) noexcept : handle(other.handle) {
+            other.handle = nullptr;
+        }
+
+        Task & operator=(Task && other) noexcept {
+            if (this != &other) {
+                destroy();
+                handle = other.handle;
+                other.handle = nullptr;
+            }
+
+            return *this;
+        }
+
+        ~Task() {
+            destroy();
+        }
+
+        bool done() const { return !handle || handle.done(); }
+
+    private:
+
+        Handle handle;
+
+        void destroy();
+};
@@ -0,0 +1,126 @@
+#include "TaskScheduler.h"
+
+#include <cmath>
+
+#include <Engine/EngineInternal/Time.h>
+#include <Profiling/Profile.h>
+
+TaskScheduler::TaskScheduler() : wheel(WHEEL_SIZE) {}
+
+uint64_t TaskScheduler::ticksFor(const std::chrono::milliseconds & duration) {
+    if (duration.count() <= 0) return 0;
+
+    double seconds = static_cast<double>(duration.count()) / 1000.0;
+
+    return static_cast<uint64_t>(std::ceil(seconds / Time::Instance().fixedDeltaTime - 1e-9));
+}
+
+int32_t TaskScheduler::createEntry(const Task::Handle & handle) {
+    int32_t id;
+
+    if (!freeEntries.empty()) {
+        id = freeEntries.back();
+        freeEntries.pop_back();
+    }
+    else {
+        id = static_cast<int32_t>(entries.size());
+        entries.emplace_back();
+    }
+
+    entries[id].handle = handle;
+    handle.promise().waitId = id;
+    waitingCount++;
+
+    return id;
+}
+
+void TaskScheduler::schedule(const Task::Handle & handle, const uint64_t & tick) {
+    uint64_t due = tick > currentTick ? tick : currentTick + 1;
+
+    int32_t id = createEntry(handle);
+    entries[id].dueTick = due;
+
+    wheel[due % WHEEL_SIZE].push_back(id);
+}
+
+void TaskScheduler::poll(const Task::Handle & handle, const std::function<bool()> & ready) {
+    int32_t id = createEntry(handle);
+    entries[id].ready = ready;
+
+    polled.push_back(id);
+}
+
+void TaskScheduler::cancel(const int32_t & id) {
+    /// Slot or polled list still refers to the entry, it is freed when visited
+    entries[id].handle = nullptr;
+    entries[id].ready = nullptr;
+    waitingCount--;
+}
+
+void TaskScheduler::resume(const int32_t & id) {
+    Task::Handle handle = entries[id].handle;
+
+    /// Destroyed by coroutine resumed earlier in this tick
+    if (!handle) {
+        freeEntries.push_back(id);
+        return;
+    }
+
+    entries[id].handle = nullptr;
+    entries[id].ready = nullptr;
+    freeEntries.push_back(id);
+    waitingCount--;
+
+    handle.promise().waitId = -1;
+    handle.resume();
+}
+
+void TaskScheduler::tick() {
+    PROFILE_FUNCTION();
+
+    currentTick++;
+    resumed.clear();
+
+    /// Coroutines resumed now may schedule into this slot again (full rotation), so it is swapped out first
+    std::vector<int32_t> slot;
+    slot.swap(wheel[currentTick % WHEEL_SIZE]);
+
+    for (int32_t id : slot) {
+        if (!entries[id].handle) {
+            freeEntries.push_back(id);
+        }
+        else if (entries[id].dueTick > currentTick) {
+            wheel[currentTick % WHEEL_SIZE].push_back(id);
+        }
+        else {
+            resumed.push_back(id);
+        }
+    }
+
+    size_t kept = 0;
+
+    for (int32_t id : polled) {
+        if (!entries[id].handle) {
+            freeEntries.push_back(id);
+        }
+        else if (entries[id].ready()) {
+            resumed.push_back(id);
+        }
+        else {
+            polled[kept++] = id;
+        }
+    }
+
+    polled.resize(kept);
+
+    /// Slot vector keeps its capacity for next rotation
+    slot.clear();
+
+    if (wheel[currentTick % WHEEL_SIZE].empty()) {
+        wheel[currentTick % WHEEL_SIZE].swap(slot);
+    }
+
+    for (int32_t id : resumed) {
+        resume(id);
+    }
+}
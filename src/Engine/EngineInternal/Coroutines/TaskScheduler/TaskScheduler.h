@@ -0,0 +1,136 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include <Coroutines/Task/Task.h>
+
+/// Resumes suspended behaviour coroutines when they are due.
+///
+/// Timed waits are kept in a timer wheel with one slot per simulation tick, so every tick looks only at
+/// coroutines in the current slot - cost depends on how many wake up, not how many are sleeping.
+/// Waits longer than the wheel stay in their slot for more rotations. Coroutines waiting for futures
+/// are polled every tick, there are only a few of them at a time (asset loads).
+///
+/// Not thread safe - coroutines are started and resumed on simulation thread.
+class TaskScheduler {
+
+    private:
+
+        struct WaitEntry {
+            /// Null once cancelled or resumed
+            Task::Handle handle;
+            uint64_t dueTick = 0;
+            std::function<bool()> ready;
+        };
+
+        std::vector<WaitEntry> entries;
+        std::vector<int32_t> freeEntries;
+
+        /// Entry ids of timed waits per slot
+        std::vector<std::vector<int32_t>> wheel;
+
+        /// Entry ids of waits for futures
+        std::vector<int32_t> polled;
+
+        std::vector<int32_t> resumed;
+
+        uint64_t currentTick = 0;
+
+        size_t waitingCount = 0;
+
+        int32_t createEntry(const Task::Handle & handle);
+
+        void resume(const int32_t & id);
+
+    public:
+
+        /// Ticks covered by one rotation of the wheel
+        static constexpr size_t WHEEL_SIZE = 1024;
+
+        /// Never destroyed - tasks of behaviours released during static destruction still cancel their waits
+        static TaskScheduler & Instance() {
+            static TaskScheduler * instance = new TaskScheduler();
+            return *instance;
+        }
+
+        TaskScheduler();
+
+        /// Suspends coroutine until given simulation tick
+        void schedule(const Task::Handle & handle, const uint64_t & tick);
+
+        /// Suspends coroutine until ready returns true, checked once per tick
+        void poll(const Task::Handle & handle, const std::function<bool()> & ready);
+
+        /// Forgets wait of destroyed coroutine
+        void cancel(const int32_t & id);
+
+        /// Advances to next simulation tick and resumes coroutines due in it
+        void tick();
+
+        uint64_t getCurrentTick() const { return currentTick; }
+
+        size_t getWaitingCount() const { return waitingCount; }
+
+        /// Number of coroutines resumed during last tick
+        size_t getResumedCount() const { return resumed.size(); }
+
+        static uint64_t ticksFor(const std::chrono::milliseconds & duration);
+};
+
+/// co_await wait(std::chrono::milliseconds(250)) - resumes after at least given time of simulation,
+/// rounded up to whole ticks
+struct WaitAwaiter {
+    uint64_t ticks;
+
+    bool await_ready() const { return ticks == 0; }
+
+    void await_suspend(const Task::Handle & handle) const {
+        auto & scheduler = TaskScheduler::Instance();
+        scheduler.schedule(handle, scheduler.getCurrentTick() + ticks);
+    }
+
+    void await_resume() const {}
+};
+
+inline WaitAwaiter wait(const std::chrono::milliseconds & duration) {
+    return WaitAwaiter { TaskScheduler::ticksFor(duration) };
+}
+
+/// co_await nextTick() - resumes in next simulation tick
+inline WaitAwaiter nextTick() {
+    return WaitAwaiter { 1 };
+}
+
+/// co_await waitTicks(n) - resumes after n simulation ticks, does not suspend for 0
+inline WaitAwaiter waitTicks(const uint64_t & ticks) {
+    return WaitAwaiter { ticks };
+}
+
+/// co_await loaded(future) - resumes in first tick after asset is loaded, returns loaded value
+template<typename T>
+struct LoadedAwaiter {
+    std::shared_future<T> future;
+
+    bool await_ready() const {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void await_suspend(const Task::Handle & handle) const {
+        std::shared_future<T> pending = future;
+
+        TaskScheduler::Instance().poll(handle, [pending]() {
+            return pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        });
+    }
+
+    const T & await_resume() const { return future.get(); }
+};
+
+template<typename T>
+LoadedAwaiter<T> loaded(const std::shared_future<T> & future) {
+    return LoadedAwaiter<T> { future };
+}
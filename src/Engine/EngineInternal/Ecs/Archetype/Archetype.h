@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <Ecs/ComponentType.h>
+#include <Ecs/Entity.h>
+
+/// Type erased array of one component type
+class ComponentColumn {
+
+    public:
+
+        virtual ~ComponentColumn() = default;
+
+        /// Empty column of the same type
+        virtual std::unique_ptr<ComponentColumn> createEmpty() const = 0;
+
+        /// Appends element moved out of other column of the same type
+        virtual void pushFrom(ComponentColumn & source, const size_t & row) = 0;
+
+        /// Removes element by moving last element into its place
+        virtual void swapRemove(const size_t & row) = 0;
+
+        /// Appends default constructed element
+        virtual void pushDefault() = 0;
+
+        virtual void reserve(const size_t & capacity) = 0;
+};
+
+template<typename T>
+class TypedColumn : public ComponentColumn {
+
+    public:
+
+        std::vector<T> data;
+
+        std::unique_ptr<ComponentColumn> createEmpty() const override {
+            return std::make_unique<TypedColumn<T>>();
+        }
+
+        void pushFrom(ComponentColumn & source, const size_t & row) override {
+            data.push_back(std::move(static_cast<TypedColumn<T> &>(source).data[row]));
+        }
+
+        void swapRemove(const size_t & row) override {
+            if (row + 1 != data.size()) {
+                data[row] = std::move(data.back());
+            }
+
+            data.pop_back();
+        }
+
+        void pushDefault() override {
+            data.emplace_back();
+        }
+
+        void reserve(const size_t & capacity) override {
+            data.reserve(capacity);
+        }
+};
+
+/// All entities with exactly the same set of components. Every component type is stored in its own
+/// contiguous column, row of entity is the same in all columns.
+class Archetype {
+
+    public:
+
+        ComponentMask mask = 0;
+
+        std::vector<Entity> entities;
+
+        std::vector<std::unique_ptr<ComponentColumn>> columns;
+
+        /// Column of every component type or -1
+        int columnIndexes[MAX_COMPONENT_TYPES];
+
+        /// Archetype reached by adding / removing component type, -1 until first used
+        int addEdges[MAX_COMPONENT_TYPES];
+        int removeEdges[MAX_COMPONENT_TYPES];
+
+        Archetype() {
+            for (uint32_t i = 0; i < MAX_COMPONENT_TYPES; i++) {
+                columnIndexes[i] = -1;
+                addEdges[i] = -1;
+                removeEdges[i] = -1;
+            }
+        }
+
+        size_t size() const { return entities.size(); }
+
+        bool contains(const ComponentMask & required) const { return (mask & required) == required; }
+
+        template<typename T>
+        TypedColumn<T> * column() {
+            int index = columnIndexes[ComponentTypeId<T>::get()];
+            return index < 0 ? nullptr : static_cast<TypedColumn<T> *>(columns[index].get());
+        }
+
+        template<typename T>
+        T * data() {
+            return column<T>()->data.data();
+        }
+};
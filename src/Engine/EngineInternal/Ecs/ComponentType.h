@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+/// Archetypes are identified by bit masks, so number of component types is limited
+const uint32_t MAX_COMPONENT_TYPES = 64;
+
+typedef uint64_t ComponentMask;
+
+/// Access mask of code which may touch any component
+const ComponentMask ALL_COMPONENTS = ~ComponentMask(0);
+
+class ComponentTypes {
+
+    public:
+
+        static uint32_t next() {
+            static uint32_t count = 0;
+
+            if (count == MAX_COMPONENT_TYPES) {
+                std::cerr << "Too many component types, limit is " << MAX_COMPONENT_TYPES << std::endl;
+                std::abort();
+            }
+
+            return count++;
+        }
+};
+
+/// Dense id of component type, assigned on first use
+template<typename T>
+class ComponentTypeId {
+
+    public:
+
+        static uint32_t get() {
+            static const uint32_t id = ComponentTypes::next();
+            return id;
+        }
+
+        static ComponentMask mask() { return ComponentMask(1) << get(); }
+};
+
+template<typename... Ts>
+ComponentMask componentMask() {
+    ComponentMask mask = 0;
+    using expand = int[];
+    (void) expand { 0, ((mask |= ComponentTypeId<Ts>::mask()), 0)... };
+    return mask;
+}
+
+/// Polymorphic components are stored under their kind - the class that declares `typedef X Kind`,
+/// so mesh component subclasses share one column. Classes without Kind are stored under their own type.
+template<typename T, typename = void>
+struct ComponentKind {
+    typedef T Type;
+};
+
+template<typename T>
+struct ComponentKind<T, typename std::enable_if<!std::is_same<typename T::Kind, void>::value>::type> {
+    typedef typename T::Kind Type;
+};
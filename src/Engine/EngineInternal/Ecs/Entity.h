@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+/// Handle of entity in World. Generation changes when index is reused, so stale handles are detected.
+struct Entity {
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    static const uint32_t INVALID_INDEX = 0xffffffffu;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const Entity & other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity & other) const { return !(*this == other); }
+};
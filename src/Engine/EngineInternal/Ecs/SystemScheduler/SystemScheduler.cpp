@@ -0,0 +1,116 @@
+#include "SystemScheduler.h"
+
+#include <algorithm>
+
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+#include <Components/Behaviour/BehaviourComponent.h>
+#include <Profiling/Profile.h>
+
+std::string SystemScheduler::typeName(const std::type_info & type) {
+    std::string name = type.name();
+
+#if defined(__GNUG__)
+    int status = 0;
+    char * demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+
+    if (status == 0 && demangled) {
+        name = demangled;
+    }
+
+    std::free(demangled);
+#else
+    for (const char * prefix : { "class ", "struct " }) {
+        if (name.rfind(prefix, 0) == 0) {
+            name = name.substr(std::string(prefix).size());
+            break;
+        }
+    }
+#endif
+
+    return name;
+}
+
+bool SystemScheduler::conflicts(const System & first, const System & second) {
+    return (first.writes & (second.reads | second.writes)) != 0 || (second.writes & first.reads) != 0;
+}
+
+void SystemScheduler::addSystem(const System & system) {
+    systems.push_back(system);
+    buildPhases();
+}
+
+void SystemScheduler::buildPhases() {
+    phases.clear();
+
+    std::vector<size_t> systemPhases(systems.size(), 0);
+
+    for (size_t i = 0; i < systems.size(); i++) {
+        size_t phase = 0;
+
+        for (size_t j = 0; j < i; j++) {
+            if (conflicts(systems[i], systems[j])) {
+                phase = std::max(phase, systemPhases[j] + 1);
+            }
+        }
+
+        systemPhases[i] = phase;
+
+        if (phase == phases.size()) {
+            phases.emplace_back();
+        }
+
+        phases[phase].push_back(i);
+    }
+}
+
+void SystemScheduler::queueStart(const std::shared_ptr<BehaviourComponent> & behaviour) {
+    pendingStarts.push_back(behaviour);
+}
+
+void SystemScheduler::startPending() {
+    /// Start may add more behaviours
+    while (!pendingStarts.empty()) {
+        std::vector<std::weak_ptr<BehaviourComponent>> starting;
+        starting.swap(pendingStarts);
+
+        for (auto & pending : starting) {
+            if (auto behaviour = pending.lock()) {
+                behaviour->Start();
+            }
+        }
+    }
+}
+
+void SystemScheduler::update(World & world, const float & deltaTime) {
+    PROFILE_FUNCTION();
+
+    startPending();
+
+    auto & jobs = JobSystem::Instance();
+
+    for (auto & phase : phases) {
+        if (phase.size() == 1) {
+            auto & system = systems[phase[0]];
+            PROFILE_SCOPE(system.name);
+            system.update(world, deltaTime);
+            continue;
+        }
+
+        JobCounter counter;
+
+        for (size_t index : phase) {
+            auto & system = systems[index];
+
+            jobs.run([&system, &world, deltaTime]() {
+                PROFILE_SCOPE(system.name);
+                system.update(world, deltaTime);
+            }, &counter);
+        }
+
+        jobs.wait(counter);
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <Ecs/World/World.h>
+
+class BehaviourComponent;
+
+/// Batch update of all entities it is interested in. Access masks list component types the system reads and writes,
+/// Transform also covers TransformStorage state of its slot.
+struct System {
+    /// Static string, used as profiler zone name
+    const char * name = "System";
+
+    ComponentMask reads = 0;
+    ComponentMask writes = 0;
+
+    std::function<void(World & world, const float & deltaTime)> update;
+};
+
+/// Runs registered systems once per simulation tick.
+///
+/// Systems are grouped into phases in registration order - system goes to the first phase after all earlier
+/// systems it conflicts with (one writes what other reads or writes). Systems of one phase run in parallel.
+class SystemScheduler {
+
+    private:
+
+        std::vector<System> systems;
+
+        /// Indexes of systems in every phase
+        std::vector<std::vector<size_t>> phases;
+
+        /// Behaviour types which already have their system
+        ComponentMask behaviourTypes = 0;
+
+        /// Behaviours added since last update, started before systems run
+        std::vector<std::weak_ptr<BehaviourComponent>> pendingStarts;
+
+        void startPending();
+
+        static bool conflicts(const System & first, const System & second);
+
+        void buildPhases();
+
+        /// Readable name of type (demangled on GCC and Clang, without "class " on MSVC)
+        static std::string typeName(const std::type_info & type);
+
+    public:
+
+        /// Objects per batch of behaviour update
+        static constexpr size_t BEHAVIOUR_BATCH = 512;
+
+        static SystemScheduler & Instance() {
+            static SystemScheduler instance;
+            return instance;
+        }
+
+        void addSystem(const System & system);
+
+        /// Registers system calling Update of all behaviours of type T, done on first addComponent of that type.
+        /// Behaviours declaring their access (see BehaviourComponent::reads) are updated in parallel batches.
+        /// Behaviours which do not override Update (coroutine driven) get no system.
+        template<typename T>
+        void addBehaviour();
+
+        /// Start of behaviour is called on simulation thread in next update
+        void queueStart(const std::shared_ptr<BehaviourComponent> & behaviour);
+
+        void update(World & world, const float & deltaTime);
+
+        size_t getSystemCount() const { return systems.size(); }
+
+        size_t getPhaseCount() const { return phases.size(); }
+};
+
+template<typename T>
+void SystemScheduler::addBehaviour() {
+    typedef std::shared_ptr<T> Column;
+
+    ComponentMask type = ComponentTypeId<Column>::mask();
+
+    if (behaviourTypes & type) return;
+
+    behaviourTypes |= type;
+
+    if constexpr (std::is_same<decltype(&T::Update), void (BehaviourComponent::*)()>::value) return;
+
+    /// Profiler keeps zone names as pointers, so name lives as long as the program
+    static const std::string name = typeName(typeid(T));
+
+    System system;
+    system.name = name.c_str();
+    system.reads = T::reads() | type;
+    system.writes = T::writes();
+
+    if (system.writes == ALL_COMPONENTS) {
+        system.update = [](World & world, const float &) {
+            world.each<Column>([](const Entity &, Column & behaviour) {
+                behaviour->T::Update();
+            });
+        };
+    }
+    else {
+        system.update = [](World & world, const float &) {
+            world.eachChunkParallel<Column>(BEHAVIOUR_BATCH, [](size_t count, const Entity *, Column * behaviours) {
+                for (size_t i = 0; i < count; i++) {
+                    behaviours[i]->T::Update();
+                }
+            });
+        };
+    }
+
+    addSystem(system);
+}
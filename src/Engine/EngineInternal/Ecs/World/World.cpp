@@ -0,0 +1,156 @@
+#include "World.h"
+
+World::World() {
+    auto empty = std::make_unique<Archetype>();
+    archetypeIndexes[0] = 0;
+    archetypes.push_back(std::move(empty));
+}
+
+const World::EntityRecord * World::findRecord(const Entity & entity) const {
+    if (entity.index >= records.size()) return nullptr;
+
+    const EntityRecord & record = records[entity.index];
+
+    if (!record.alive || record.generation != entity.generation) return nullptr;
+
+    return &record;
+}
+
+Entity World::create(const uint32_t & archetype) {
+    uint32_t index;
+
+    if (!freeIndexes.empty()) {
+        index = freeIndexes.back();
+        freeIndexes.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+
+    Entity entity;
+    entity.index = index;
+    entity.generation = records[index].generation;
+
+    Archetype & target = *archetypes[archetype];
+
+    for (auto & column : target.columns) {
+        column->pushDefault();
+    }
+
+    records[index].archetype = archetype;
+    records[index].row = static_cast<uint32_t>(target.entities.size());
+    records[index].alive = true;
+
+    target.entities.push_back(entity);
+
+    return entity;
+}
+
+void World::reserve(const uint32_t & archetype, const size_t & count) {
+    Archetype & target = *archetypes[archetype];
+    size_t capacity = target.entities.size() + count;
+
+    target.entities.reserve(capacity);
+
+    for (auto & column : target.columns) {
+        column->reserve(capacity);
+    }
+}
+
+void World::reserve(const size_t & count) {
+    if (count > freeIndexes.size()) {
+        records.reserve(records.size() + count - freeIndexes.size());
+    }
+}
+
+void World::destroy(const Entity & entity) {
+    const EntityRecord * record = findRecord(entity);
+    if (!record) return;
+
+    uint32_t archetype = record->archetype;
+    uint32_t row = record->row;
+
+    EntityRecord & mutableRecord = records[entity.index];
+    mutableRecord.alive = false;
+    mutableRecord.generation++;
+
+    removeRow(*archetypes[archetype], row);
+
+    freeIndexes.push_back(entity.index);
+}
+
+void World::removeRow(Archetype & archetype, const uint32_t & row) {
+    for (auto & column : archetype.columns) {
+        column->swapRemove(row);
+    }
+
+    if (row + 1 != archetype.entities.size()) {
+        Entity moved = archetype.entities.back();
+        archetype.entities[row] = moved;
+        records[moved.index].row = row;
+    }
+
+    archetype.entities.pop_back();
+}
+
+uint32_t World::moveEntity(const Entity & entity, const uint32_t & target) {
+    EntityRecord & record = records[entity.index];
+
+    Archetype & from = *archetypes[record.archetype];
+    Archetype & to = *archetypes[target];
+
+    for (uint32_t id = 0; id < MAX_COMPONENT_TYPES; id++) {
+        int fromColumn = from.columnIndexes[id];
+        int toColumn = to.columnIndexes[id];
+
+        if (fromColumn >= 0 && toColumn >= 0) {
+            to.columns[toColumn]->pushFrom(*from.columns[fromColumn], record.row);
+        }
+    }
+
+    uint32_t row = static_cast<uint32_t>(to.entities.size());
+    to.entities.push_back(entity);
+
+    removeRow(from, record.row);
+
+    record.archetype = target;
+    record.row = row;
+
+    return row;
+}
+
+uint32_t World::findRemoveTarget(const uint32_t & source, const uint32_t & typeId) {
+    int cached = archetypes[source]->removeEdges[typeId];
+    if (cached >= 0) return static_cast<uint32_t>(cached);
+
+    const Archetype & from = *archetypes[source];
+    ComponentMask mask = from.mask & ~(ComponentMask(1) << typeId);
+
+    auto found = archetypeIndexes.find(mask);
+    uint32_t target;
+
+    if (found != archetypeIndexes.end()) {
+        target = found->second;
+    }
+    else {
+        auto archetype = std::make_unique<Archetype>();
+        archetype->mask = mask;
+
+        for (uint32_t id = 0; id < MAX_COMPONENT_TYPES; id++) {
+            if (!(mask & (ComponentMask(1) << id))) continue;
+
+            archetype->columnIndexes[id] = static_cast<int>(archetype->columns.size());
+            archetype->columns.push_back(from.columns[from.columnIndexes[id]]->createEmpty());
+        }
+
+        target = static_cast<uint32_t>(archetypes.size());
+        archetypes.push_back(std::move(archetype));
+        archetypeIndexes[mask] = target;
+    }
+
+    archetypes[source]->removeEdges[typeId] = static_cast<int>(target);
+    archetypes[target]->addEdges[typeId] = static_cast<int>(source);
+
+    return target;
+}
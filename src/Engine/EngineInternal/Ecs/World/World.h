@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Ecs/Archetype/Archetype.h>
+#include <Jobs/JobSystem/JobSystem.h>
+
+/// Archetype based entity component storage.
+///
+/// Entity's components live in the archetype matching its component set, one contiguous column per type,
+/// so queries iterate dense arrays of column values. Column of shared pointers is dense only in pointers,
+/// each component is still a separate allocation. Adding or removing component moves entity to another archetype.
+/// Component access through entity is O(1): entity record -> archetype row -> column.
+///
+/// Structural changes (create, destroy, add, remove) are done on main thread, outside of queries.
+class World {
+
+    private:
+
+        struct EntityRecord {
+            uint32_t archetype = 0;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+            bool alive = false;
+        };
+
+        std::vector<EntityRecord> records;
+        std::vector<uint32_t> freeIndexes;
+
+        /// Archetype 0 has no components
+        std::vector<std::unique_ptr<Archetype>> archetypes;
+
+        std::unordered_map<ComponentMask, uint32_t> archetypeIndexes;
+
+        const EntityRecord * findRecord(const Entity & entity) const;
+
+        /// Moves entity with all shared components to target archetype, returns its new row
+        uint32_t moveEntity(const Entity & entity, const uint32_t & target);
+
+        /// Removes row from archetype and fixes record of entity moved into its place
+        void removeRow(Archetype & archetype, const uint32_t & row);
+
+        /// Target archetype differs from source by one column - created from source columns
+        template<typename T>
+        uint32_t findAddTarget(const uint32_t & source);
+
+        uint32_t findRemoveTarget(const uint32_t & source, const uint32_t & typeId);
+
+    public:
+
+        World();
+
+        /// Never destroyed - objects released during static destruction still destroy their entities
+        static World & Instance() {
+            static World * instance = new World();
+            return *instance;
+        }
+
+        /// Entity without components
+        Entity create() { return create(0); }
+
+        /// Entity created directly in archetype, with default constructed components set in place through get.
+        /// Bulk creation path - entity is not moved between archetypes as its components are added one by one.
+        Entity create(const uint32_t & archetype);
+
+        /// Archetype reached from given one by adding T, created on first use. Archetype 0 has no components.
+        template<typename T>
+        uint32_t archetypeWith(const uint32_t & archetype) { return findAddTarget<T>(archetype); }
+
+        /// Grows entities and all columns of archetype once before creating count entities in it
+        void reserve(const uint32_t & archetype, const size_t & count);
+
+        /// Grows entity records once before creating count entities in any archetypes
+        void reserve(const size_t & count);
+
+        void destroy(const Entity & entity);
+
+        bool isAlive(const Entity & entity) const { return findRecord(entity) != nullptr; }
+
+        /// Adds component or replaces existing one. Returns nullptr when entity is not alive.
+        template<typename T>
+        T * add(const Entity & entity, T component);
+
+        template<typename T>
+        void remove(const Entity & entity);
+
+        template<typename T>
+        bool has(const Entity & entity) const {
+            const EntityRecord * record = findRecord(entity);
+            return record && archetypes[record->archetype]->contains(ComponentTypeId<T>::mask());
+        }
+
+        /// Component of entity or nullptr
+        template<typename T>
+        T * tryGet(const Entity & entity) {
+            const EntityRecord * record = findRecord(entity);
+            if (!record) return nullptr;
+
+            TypedColumn<T> * column = archetypes[record->archetype]->template column<T>();
+            return column ? &column->data[record->row] : nullptr;
+        }
+
+        template<typename T>
+        const T * tryGet(const Entity & entity) const {
+            return const_cast<World *>(this)->tryGet<T>(entity);
+        }
+
+        template<typename T>
+        T & get(const Entity & entity) {
+            return *tryGet<T>(entity);
+        }
+
+        /// Calls fn(entity, components...) for every entity having all given components
+        template<typename... Ts, typename F>
+        void each(F && fn) {
+            ComponentMask required = componentMask<Ts...>();
+
+            for (auto & archetype : archetypes) {
+                if (!archetype->contains(required) || archetype->size() == 0) continue;
+
+                auto arrays = std::make_tuple(archetype->template data<Ts>()...);
+                const Entity * entities = archetype->entities.data();
+
+                for (size_t row = 0; row < archetype->size(); row++) {
+                    fn(entities[row], std::get<Ts *>(arrays)[row]...);
+                }
+            }
+        }
+
+        /// Calls fn(count, entities, arrays...) for runs of at most chunkSize entities sharing an archetype.
+        /// Arrays are dense, so systems can process whole batch in one loop.
+        template<typename... Ts, typename F>
+        void eachChunk(const size_t & chunkSize, F && fn) {
+            ComponentMask required = componentMask<Ts...>();
+
+            for (auto & archetype : archetypes) {
+                if (!archetype->contains(required)) continue;
+
+                size_t size = archetype->size();
+
+                for (size_t begin = 0; begin < size; begin += chunkSize) {
+                    size_t count = std::min(chunkSize, size - begin);
+                    fn(count, archetype->entities.data() + begin, (archetype->template data<Ts>() + begin)...);
+                }
+            }
+        }
+
+        /// Like eachChunk, but chunks are processed by job system workers. Fn must touch only rows it was given.
+        template<typename... Ts, typename F>
+        void eachChunkParallel(const size_t & chunkSize, F && fn) {
+            ComponentMask required = componentMask<Ts...>();
+            auto & jobs = JobSystem::Instance();
+
+            for (auto & archetype : archetypes) {
+                if (!archetype->contains(required) || archetype->size() == 0) continue;
+
+                Archetype * chunkArchetype = archetype.get();
+
+                jobs.parallelFor(0, archetype->size(), chunkSize, [&fn, chunkArchetype](size_t begin, size_t end) {
+                    fn(end - begin, chunkArchetype->entities.data() + begin, (chunkArchetype->template data<Ts>() + begin)...);
+                });
+            }
+        }
+
+        /// Number of entities having all given components
+        template<typename... Ts>
+        size_t count() const {
+            ComponentMask required = componentMask<Ts...>();
+            size_t result = 0;
+
+            for (auto & archetype : archetypes) {
+                if (archetype->contains(required)) {
+                    result += archetype->size();
+                }
+            }
+
+            return result;
+        }
+
+        size_t getArchetypeCount() const { return archetypes.size(); }
+};
+
+template<typename T>
+uint32_t World::findAddTarget(const uint32_t & source) {
+    uint32_t typeId = ComponentTypeId<T>::get();
+
+    int cached = archetypes[source]->addEdges[typeId];
+    if (cached >= 0) return static_cast<uint32_t>(cached);
+
+    ComponentMask mask = archetypes[source]->mask | ComponentTypeId<T>::mask();
+
+    auto found = archetypeIndexes.find(mask);
+    uint32_t target;
+
+    if (found != archetypeIndexes.end()) {
+        target = found->second;
+    }
+    else {
+        auto archetype = std::make_unique<Archetype>();
+        archetype->mask = mask;
+
+        /// Columns are ordered by type id, so archetypes built through different paths look the same
+        for (uint32_t id = 0; id < MAX_COMPONENT_TYPES; id++) {
+            if (!(mask & (ComponentMask(1) << id))) continue;
+
+            archetype->columnIndexes[id] = static_cast<int>(archetype->columns.size());
+
+            if (id == typeId) {
+                archetype->columns.push_back(std::make_unique<TypedColumn<T>>());
+            }
+            else {
+                const Archetype & from = *archetypes[source];
+                archetype->columns.push_back(from.columns[from.columnIndexes[id]]->createEmpty());
+            }
+        }
+
+        target = static_cast<uint32_t>(archetypes.size());
+        archetypes.push_back(std::move(archetype));
+        archetypeIndexes[mask] = target;
+    }
+
+    archetypes[source]->addEdges[typeId] = static_cast<int>(target);
+    archetypes[target]->removeEdges[typeId] = static_cast<int>(source);
+
+    return target;
+}
+
+template<typename T>
+T * World::add(const Entity & entity, T component) {
+    const EntityRecord * record = findRecord(entity);
+    if (!record) return nullptr;
+
+    /// Replace existing component in place
+    if (T * existing = tryGet<T>(entity)) {
+        *existing = std::move(component);
+        return existing;
+    }
+
+    uint32_t target = findAddTarget<T>(record->archetype);
+    Archetype & archetype = *archetypes[target];
+
+    /// New column is filled first, shared columns are moved after it
+    TypedColumn<T> * column = archetype.template column<T>();
+    column->data.push_back(std::move(component));
+
+    uint32_t row = moveEntity(entity, target);
+
+    return &column->data[row];
+}
+
+template<typename T>
+void World::remove(const Entity & entity) {
+    const EntityRecord * record = findRecord(entity);
+    if (!record || !archetypes[record->archetype]->contains(ComponentTypeId<T>::mask())) return;
+
+    uint32_t source = record->archetype;
+    uint32_t row = record->row;
+
+    uint32_t target = findRemoveTarget(source, ComponentTypeId<T>::get());
+
+    /// Removed component is dropped from source once entity moved out
+    Archetype & from = *archetypes[source];
+    TypedColumn<T> * column = from.template column<T>();
+    T removed = std::move(column->data[row]);
+
+    moveEntity(entity, target);
+}
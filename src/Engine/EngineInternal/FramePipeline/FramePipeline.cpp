@@ -0,0 +1,17 @@
+#include "FramePipeline.h"
+
+#include <Profiling/Profile.h>
+
+FramePipeline::~FramePipeline() {
+    wait();
+}
+
+void FramePipeline::kick(const std::function<void()> & frameWork) {
+    wait();
+    JobSystem::Instance().run(frameWork, &counter);
+}
+
+void FramePipeline::wait() {
+    PROFILE_FUNCTION();
+    JobSystem::Instance().wait(counter);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <functional>
+
+#include <Jobs/JobSystem/JobSystem.h>
+
+/// Runs CPU work of next frame (simulation, culling, matrices) as a job,
+/// while GL thread submits current one. At most one frame of work is in flight.
+class FramePipeline {
+
+    private:
+
+        JobCounter counter;
+
+    public:
+
+        FramePipeline() = default;
+
+        ~FramePipeline();
+
+        FramePipeline(FramePipeline const &) = delete;
+
+        void operator=(FramePipeline const &) = delete;
+
+        /// Starts work on job system. Previous work must be finished (see wait())
+        void kick(const std::function<void()> & frameWork);
+
+        /// Blocks until kicked work is finished, helping with jobs in the meantime
+        void wait();
+};
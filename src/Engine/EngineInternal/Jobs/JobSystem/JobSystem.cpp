@@ -0,0 +1,280 @@
+#include "JobSystem.h"
+
+#include <string>
+
+#include <Profiling/Profile.h>
+
+namespace {
+    /// Queue index of current thread for every job system it belongs to (benchmarks run several systems)
+    thread_local const JobSystem * threadJobSystem = nullptr;
+    thread_local int threadQueueIndex = -1;
+}
+
+JobSystem::JobSystem(const unsigned int & workerCount) {
+    mainThreadId = std::this_thread::get_id();
+
+    for (unsigned int i = 0; i < workerCount + 1; i++) {
+        queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (unsigned int i = 1; i <= workerCount; i++) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false);
+    }
+
+    sleepCondition.notify_all();
+
+    for (auto & worker : workers) {
+        worker.join();
+    }
+}
+
+int JobSystem::currentQueueIndex() const {
+    if (threadJobSystem == this) {
+        return threadQueueIndex;
+    }
+
+    return isMainThread() ? 0 : -1;
+}
+
+void JobSystem::workerLoop(const unsigned int & index) {
+    threadJobSystem = this;
+    threadQueueIndex = static_cast<int>(index);
+
+#ifdef ENGINE_PROFILING
+    CpuProfiler::Instance().setThreadName("Worker " + std::to_string(index));
+#endif
+
+    while (running.load(std::memory_order_acquire)) {
+        /// Read before looking for work - job made runnable afterwards changes it, so its wake up is not lost
+        uint64_t generation = wakeGeneration.load(std::memory_order_acquire);
+
+        if (executeNext(index, false)) {
+            continue;
+        }
+
+        /// Queues busy while stealing are checked once more before sleeping
+        Job job;
+
+        if (steal(index, job, true)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+
+        sleepCondition.wait(lock, [this, generation]() {
+            return wakeGeneration.load(std::memory_order_acquire) != generation || !running.load(std::memory_order_acquire);
+        });
+    }
+}
+
+void JobSystem::wake(const bool & all) {
+    {
+        /// Taking the lock orders this notification after a worker's predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    if (all) {
+        sleepCondition.notify_all();
+    }
+    else {
+        sleepCondition.notify_one();
+    }
+}
+
+void JobSystem::push(const unsigned int & queueIndex, Job job) {
+    const JobCounter * dependency = job.dependency;
+
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->jobs.push_back(std::move(job));
+    }
+
+    /// Blocked job is woken for when its dependency completes. Checked after the job is queued,
+    /// so dependency completing in between still finds it.
+    if (!dependency || dependency->done()) {
+        wake(false);
+    }
+}
+
+void JobSystem::run(const std::function<void()> & function, JobCounter * counter, const JobCounter * dependency) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job;
+    job.function = function;
+    job.counter = counter;
+    job.dependency = dependency;
+
+    int index = currentQueueIndex();
+
+    /// Threads outside of the system spread their jobs over workers
+    if (index < 0) {
+        index = static_cast<int>(nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+    }
+
+    push(static_cast<unsigned int>(index), std::move(job));
+}
+
+void JobSystem::runOnMainThread(const std::function<void()> & function, JobCounter * counter) {
+    if (counter) {
+        counter->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job job;
+    job.function = function;
+    job.counter = counter;
+
+    std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+    mainThreadQueue.jobs.push_back(std::move(job));
+}
+
+bool JobSystem::popOwn(const unsigned int & queueIndex, Job & job) {
+    auto & queue = *queues[queueIndex];
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    /// Newest ready job first
+    for (auto it = queue.jobs.rbegin(); it != queue.jobs.rend(); ++it) {
+        if (!it->dependency || it->dependency->done()) {
+            job = std::move(*it);
+            queue.jobs.erase(std::next(it).base());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::steal(const unsigned int & thiefIndex, Job & job, const bool & blocking) {
+    auto count = static_cast<unsigned int>(queues.size());
+
+    for (unsigned int offset = 1; offset < count; offset++) {
+        auto & queue = *queues[(thiefIndex + offset) % count];
+
+        std::unique_lock<std::mutex> lock(queue.mutex, std::defer_lock);
+
+        if (blocking) {
+            lock.lock();
+        }
+        else if (!lock.try_lock()) {
+            continue;
+        }
+
+        /// Oldest ready job first
+        for (auto it = queue.jobs.begin(); it != queue.jobs.end(); ++it) {
+            if (!it->dependency || it->dependency->done()) {
+                job = std::move(*it);
+                queue.jobs.erase(it);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::popMainThread(Job & job) {
+    std::lock_guard<std::mutex> lock(mainThreadQueue.mutex);
+
+    if (mainThreadQueue.jobs.empty()) {
+        return false;
+    }
+
+    job = std::move(mainThreadQueue.jobs.front());
+    mainThreadQueue.jobs.pop_front();
+
+    return true;
+}
+
+void JobSystem::execute(Job & job) {
+    job.function();
+
+    /// Last job of a group may unblock jobs depending on it
+    if (job.counter && job.counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        wake(true);
+    }
+}
+
+bool JobSystem::executeNext(const unsigned int & queueIndex, const bool & allowMainThreadJobs) {
+    Job job;
+
+    if (allowMainThreadJobs && popMainThread(job)) {
+        execute(job);
+        return true;
+    }
+
+    if (popOwn(queueIndex, job) || steal(queueIndex, job)) {
+        execute(job);
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::executeMainThreadJobs() {
+    PROFILE_FUNCTION();
+
+    Job job;
+
+    while (popMainThread(job)) {
+        execute(job);
+    }
+}
+
+void JobSystem::wait(const JobCounter & counter) {
+    int index = currentQueueIndex();
+    bool mainThread = isMainThread();
+
+    while (!counter.done()) {
+        if (index >= 0 && executeNext(static_cast<unsigned int>(index), mainThread)) {
+            continue;
+        }
+
+        std::this_thread::yield();
+    }
+}
+
+size_t JobSystem::defaultGrainSize(const size_t & count, const size_t & minimum) const {
+    size_t ranges = (workers.size() + 1) * 4;
+    size_t grain = (count + ranges - 1) / ranges;
+    return grain > minimum ? grain : minimum;
+}
+
+void JobSystem::parallelFor(const size_t & begin, const size_t & end, const size_t & grainSize,
+                            const std::function<void(size_t, size_t)> & function) {
+    if (begin >= end) return;
+
+    size_t grain = grainSize > 0 ? grainSize : 1;
+
+    /// Not worth scheduling - run inline
+    if (end - begin <= grain || workers.empty()) {
+        function(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+
+    size_t rangeBegin = begin;
+
+    /// First range stays on calling thread
+    size_t firstEnd = begin + grain;
+
+    for (rangeBegin = firstEnd; rangeBegin < end; rangeBegin += grain) {
+        size_t rangeEnd = rangeBegin + grain < end ? rangeBegin + grain : end;
+        run([&function, rangeBegin, rangeEnd]() { function(rangeBegin, rangeEnd); }, &counter);
+    }
+
+    function(begin, firstEnd);
+
+    wait(counter);
+}
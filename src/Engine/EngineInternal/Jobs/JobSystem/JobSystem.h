@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Number of unfinished jobs of a group. Job system decrements it when job completes.
+class JobCounter {
+
+    public:
+
+        std::atomic<int> value { 0 };
+
+        bool done() const { return value.load(std::memory_order_acquire) == 0; }
+};
+
+struct Job {
+    std::function<void()> function;
+
+    /// Decremented when job is finished (optional)
+    JobCounter * counter = nullptr;
+
+    /// Job is not started until this counter reaches zero (optional)
+    const JobCounter * dependency = nullptr;
+};
+
+/// Work stealing scheduler. Every worker owns a deque - it pushes and pops own jobs at the back (LIFO, cache warm),
+/// idle workers steal from the front of other deques (FIFO, largest remaining pieces of work).
+/// Main thread has its own deque for jobs which must run on it (GL calls).
+class JobSystem {
+
+    private:
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        /// Index 0 belongs to main thread, 1..N to workers
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+        std::vector<std::thread> workers;
+
+        WorkerQueue mainThreadQueue;
+
+        std::mutex sleepMutex;
+        std::condition_variable sleepCondition;
+
+        /// Changed whenever a job may have become runnable (pushed, or counter reached zero).
+        /// Idle workers sleep until it changes, jobs blocked by dependencies do not keep them spinning.
+        std::atomic<uint64_t> wakeGeneration { 0 };
+
+        std::atomic<bool> running { true };
+        std::atomic<unsigned int> nextQueue { 0 };
+
+        std::thread::id mainThreadId;
+
+        void workerLoop(const unsigned int & index);
+
+        int currentQueueIndex() const;
+
+        void push(const unsigned int & queueIndex, Job job);
+
+        bool popOwn(const unsigned int & queueIndex, Job & job);
+
+        /// Without blocking, queues locked by other threads are skipped
+        bool steal(const unsigned int & thiefIndex, Job & job, const bool & blocking = false);
+
+        void wake(const bool & all);
+
+        bool popMainThread(Job & job);
+
+        /// Runs single job if any is ready. Returns false when there was nothing to do.
+        bool executeNext(const unsigned int & queueIndex, const bool & allowMainThreadJobs);
+
+        void execute(Job & job);
+
+    public:
+
+        /// Uses hardware_concurrency - 1 workers, main thread is the last core
+        static JobSystem & Instance() {
+            static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+            return instance;
+        }
+
+        /// Must be created on main thread
+        explicit JobSystem(const unsigned int & workerCount);
+
+        ~JobSystem();
+
+        JobSystem(JobSystem const &) = delete;
+
+        void operator=(JobSystem const &) = delete;
+
+        unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+        bool isMainThread() const { return std::this_thread::get_id() == mainThreadId; }
+
+        void run(const std::function<void()> & function, JobCounter * counter = nullptr, const JobCounter * dependency = nullptr);
+
+        /// Job which touches GL context. Executed by executeMainThreadJobs() or by main thread waiting on counter.
+        void runOnMainThread(const std::function<void()> & function, JobCounter * counter = nullptr);
+
+        void executeMainThreadJobs();
+
+        /// Helps executing jobs until counter reaches zero, so waiting from inside job does not deadlock
+        void wait(const JobCounter & counter);
+
+        /// Splits [begin, end) into ranges of at most grainSize and runs them in parallel. Blocks until finished.
+        void parallelFor(const size_t & begin, const size_t & end, const size_t & grainSize,
+                         const std::function<void(size_t, size_t)> & function);
+
+        /// Grain size which gives every thread a few ranges to balance load
+        size_t defaultGrainSize(const size_t & count, const size_t & minimum = 256) const;
+};
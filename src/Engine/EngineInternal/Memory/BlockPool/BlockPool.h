@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+
+/// Free list allocator of fixed size blocks. Memory is taken in chunks, which grow geometrically up to
+/// MAX_CHUNK_BLOCKS and are never returned, so blocks allocated together are adjacent.
+template<size_t Size, size_t Alignment>
+class BlockPool {
+
+    private:
+
+        union Block {
+            Block * next;
+            alignas(Alignment) unsigned char storage[Size];
+        };
+
+        struct ChunkDeleter {
+            void operator()(Block * blocks) const { ::operator delete[](blocks, std::align_val_t(alignof(Block))); }
+        };
+
+        std::vector<std::unique_ptr<Block[], ChunkDeleter>> chunks;
+
+        Block * firstFree = nullptr;
+
+        size_t nextChunkBlocks = 64;
+
+        size_t capacity = 0;
+        size_t used = 0;
+
+        mutable std::mutex mutex;
+
+        void addChunk(const size_t & count) {
+            auto * blocks = static_cast<Block *>(::operator new[](count * sizeof(Block), std::align_val_t(alignof(Block))));
+            chunks.emplace_back(blocks);
+
+            /// Linked in address order, so consecutive allocations are adjacent
+            for (size_t i = count; i > 0; i--) {
+                blocks[i - 1].next = firstFree;
+                firstFree = &blocks[i - 1];
+            }
+
+            capacity += count;
+
+            MemoryTracker::Instance().add(MemoryCategory::COMPONENT_POOLS, count * sizeof(Block));
+        }
+
+        BlockPool() = default;
+
+    public:
+
+        static constexpr size_t MAX_CHUNK_BLOCKS = 16384;
+
+        /// Never destroyed - shared pointers released during static destruction still return their blocks here
+        static BlockPool & Instance() {
+            static BlockPool * instance = new BlockPool();
+            return *instance;
+        }
+
+        void * allocate() {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (!firstFree) {
+                addChunk(nextChunkBlocks);
+                nextChunkBlocks = std::min(nextChunkBlocks * 2, MAX_CHUNK_BLOCKS);
+            }
+
+            Block * block = firstFree;
+            firstFree = block->next;
+            used++;
+
+            return block;
+        }
+
+        void free(void * pointer) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto * block = static_cast<Block *>(pointer);
+            block->next = firstFree;
+            firstFree = block;
+            used--;
+        }
+
+        size_t getCapacity() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return capacity;
+        }
+
+        size_t getUsed() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return used;
+        }
+};
+
+/// Standard allocator taking single objects from BlockPool of their size. Used for control blocks of pooled
+/// shared pointers, which have implementation defined type.
+template<typename T>
+class PoolAllocator {
+
+    public:
+
+        typedef T value_type;
+
+        PoolAllocator() = default;
+
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U> &) {}
+
+        T * allocate(const size_t & count) {
+            if (count != 1) {
+                return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+            }
+
+            return static_cast<T *>(BlockPool<sizeof(T), alignof(T)>::Instance().allocate());
+        }
+
+        void deallocate(T * pointer, const size_t & count) {
+            if (count != 1) {
+                ::operator delete(pointer, std::align_val_t(alignof(T)));
+                return;
+            }
+
+            BlockPool<sizeof(T), alignof(T)>::Instance().free(pointer);
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U> &) const { return true; }
+
+        template<typename U>
+        bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
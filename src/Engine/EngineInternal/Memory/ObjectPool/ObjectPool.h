@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <Memory/BlockPool/BlockPool.h>
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+
+/// Typed pool of objects stored in fixed size chunks.
+///
+/// Objects never move, so pointers stay valid for their whole life. Handle (slot index + generation) can be
+/// stored instead of pointer and detects that object was destroyed or slot reused. Freed slots are reused first,
+/// reserve adds slots in one chunk run, so objects created in bulk are adjacent in memory.
+template<typename T>
+class ObjectPool {
+
+    private:
+
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+            uint32_t index = 0;
+            uint32_t generation = 0;
+            uint32_t nextFree = NONE;
+            bool alive = false;
+        };
+
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        std::vector<std::unique_ptr<Slot[]>> chunks;
+
+        uint32_t firstFree = NONE;
+
+        size_t aliveCount = 0;
+
+        mutable std::mutex mutex;
+
+        Slot & slotAt(const uint32_t & index) const {
+            return chunks[index / CHUNK_SLOTS][index % CHUNK_SLOTS];
+        }
+
+        void addChunk() {
+            auto base = static_cast<uint32_t>(chunks.size() * CHUNK_SLOTS);
+            chunks.emplace_back(new Slot[CHUNK_SLOTS]);
+
+            MemoryTracker::Instance().add(MemoryCategory::COMPONENT_POOLS, CHUNK_SLOTS * sizeof(Slot));
+
+            Slot * slots = chunks.back().get();
+
+            /// Linked in index order, so new objects fill the chunk front to back
+            for (uint32_t i = CHUNK_SLOTS; i > 0; i--) {
+                slots[i - 1].index = base + i - 1;
+                slots[i - 1].nextFree = firstFree;
+                firstFree = base + i - 1;
+            }
+        }
+
+        /// Returns slot to free list
+        void release(Slot * slot) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            slot->alive = false;
+            slot->generation++;
+            slot->nextFree = firstFree;
+            firstFree = slot->index;
+            aliveCount--;
+        }
+
+        ObjectPool() = default;
+
+    public:
+
+        static constexpr uint32_t CHUNK_SLOTS = 1024;
+
+        struct Handle {
+            uint32_t index = NONE;
+            uint32_t generation = 0;
+
+            bool isValid() const { return index != NONE; }
+        };
+
+        /// Never destroyed - shared pointers released during static destruction still return their objects here
+        static ObjectPool & Instance() {
+            static ObjectPool * instance = new ObjectPool();
+            return *instance;
+        }
+
+        /// Makes room for count more objects without allocating while they are created
+        void reserve(const size_t & count) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            size_t needed = aliveCount + count;
+
+            while (chunks.size() * CHUNK_SLOTS < needed) {
+                addChunk();
+            }
+        }
+
+        template<typename... Args>
+        T * create(Args &&... args) {
+            Slot * slot;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if (firstFree == NONE) {
+                    addChunk();
+                }
+
+                slot = &slotAt(firstFree);
+                firstFree = slot->nextFree;
+                slot->alive = true;
+                aliveCount++;
+            }
+
+            /// Constructor may create other pooled objects, so it runs outside of the lock
+            try {
+                return new (slot->storage) T(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                release(slot);
+                throw;
+            }
+        }
+
+        void destroy(T * object) {
+            object->~T();
+            release(reinterpret_cast<Slot *>(object));
+        }
+
+        /// Shared pointer to pooled object, its control block comes from BlockPool
+        template<typename... Args>
+        std::shared_ptr<T> makeShared(Args &&... args) {
+            return std::shared_ptr<T>(create(std::forward<Args>(args)...), [](T * object) {
+                ObjectPool<T>::Instance().destroy(object);
+            }, PoolAllocator<T>());
+        }
+
+        Handle handleOf(const T * object) const {
+            auto * slot = reinterpret_cast<const Slot *>(object);
+            return Handle { slot->index, slot->generation };
+        }
+
+        /// Object or nullptr when it was destroyed
+        T * get(const Handle & handle) const {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (handle.index >= chunks.size() * CHUNK_SLOTS) return nullptr;
+
+            Slot & slot = slotAt(handle.index);
+
+            if (!slot.alive || slot.generation != handle.generation) return nullptr;
+
+            return reinterpret_cast<T *>(slot.storage);
+        }
+
+        size_t getAliveCount() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return aliveCount;
+        }
+
+        size_t getCapacity() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return chunks.size() * CHUNK_SLOTS;
+        }
+};
+
+/// make_shared replacement - object and its control block are taken from pools
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args &&... args) {
+    return ObjectPool<T>::Instance().makeShared(std::forward<Args>(args)...);
+}
+
+/// Bulk creation - reserves room for count objects of every given type
+template<typename... Ts>
+void reservePooled(const size_t & count) {
+    using expand = int[];
+    (void) expand { 0, (ObjectPool<Ts>::Instance().reserve(count), 0)... };
+}
@@ -16,18 +16,16 @@ void PhysicsEngine::init() {
     dynamicsWorld->setGravity(btVector3(0, -10.0f, 0));
 
     Transform t;
-    t.position = glm::vec3(0.0f, -100.0f, 0.0f);
-    t.rotation = glm::vec3(0.0f);
-    t.scale = glm::vec3(200.0f, 200.0f, 200.0f);
+    t.setPosition(glm::vec3(0.0f, -100.0f, 0.0f));
+    t.setScale(glm::vec3(200.0f, 200.0f, 200.0f));
 
     addCollisionBox(0., 0.9f, t);
 }
 
 void PhysicsEngine::test() {
     Transform t;
-    t.position = glm::vec3(0.0f, 10.0f, 0.0f);
-    t.rotation = glm::vec3(0.0f);
-    t.scale = glm::vec3(1.0f);
+    t.setPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    t.setScale(glm::vec3(1.0f));
 
 
     addCollisionBox(1.0f, 0.9f, t);
@@ -39,9 +37,9 @@ int PhysicsEngine::addCollisionBox(const float & mass, const float & restitution
 
     btCollisionShape * shape = new btBoxShape(
             btVector3(
-                    btScalar(transform.scale.x / 2.0f),
-                    btScalar(transform.scale.y / 2.0f),
-                    btScalar(transform.scale.z / 2.0f)
+                    btScalar(transform.getScale().x / 2.0f),
+                    btScalar(transform.getScale().y / 2.0f),
+                    btScalar(transform.getScale().z / 2.0f)
             ));
 
     collisionShapes.push_back(shape);
@@ -49,9 +47,11 @@ int PhysicsEngine::addCollisionBox(const float & mass, const float & restitution
     /// Set transform
     btTransform t;
     t.setIdentity();
-    t.setOrigin(btVector3(transform.position.x, transform.position.y, transform.position.z));
+    glm::vec3 position = transform.getPosition();
+    t.setOrigin(btVector3(position.x, position.y, position.z));
     btQuaternion quat;
-    quat.setEuler(transform.rotation.y, transform.rotation.x, transform.rotation.z);
+    glm::vec3 rotation = transform.getRotation();
+    quat.setEuler(rotation.y, rotation.x, rotation.z);
     t.setRotation(quat);
 
 
@@ -80,15 +80,17 @@ int PhysicsEngine::addCollisionBox(const float & mass, const float & restitution
 
 
 int PhysicsEngine::addCollisionSphere(const float & mass, const float & restitution, const Transform & transform) {
-    btCollisionShape * colShape = new btSphereShape(btScalar(transform.scale.x));
+    btCollisionShape * colShape = new btSphereShape(btScalar(transform.getScale().x));
     collisionShapes.push_back(colShape);
 
     btTransform startTransform;
     startTransform.setIdentity();
-    startTransform.setOrigin(btVector3(transform.position.x, transform.position.y, transform.position.z));
+    glm::vec3 position = transform.getPosition();
+    startTransform.setOrigin(btVector3(position.x, position.y, position.z));
 
     btQuaternion quat;
-    quat.setEuler(transform.rotation.y, transform.rotation.x, transform.rotation.z);
+    glm::vec3 rotation = transform.getRotation();
+    quat.setEuler(rotation.y, rotation.x, rotation.z);
     startTransform.setRotation(quat);
 
     bool isDynamic = (mass != 0.f);
@@ -233,8 +235,8 @@ std::shared_ptr<Transform> PhysicsEngine::getTransform(const int & idx) {
 
     trans.getRotation().getEulerZYX(yawZ, pitchY, rollX);
 
-    transform->position = glm::vec3(origin.getX(), origin.getY(), origin.getZ());
-    transform->rotation = glm::vec3(rollX, pitchY, yawZ);
+    transform->setPosition(glm::vec3(origin.getX(), origin.getY(), origin.getZ()));
+    transform->setRotation(glm::vec3(rollX, pitchY, yawZ));
 
     return transform;
 }
@@ -0,0 +1,116 @@
+#include "CpuProfiler.h"
+
+#include <fstream>
+#include <iostream>
+
+CpuThreadEventBuffer * CpuProfiler::registerThread() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    auto index = static_cast<uint32_t>(buffers.size());
+
+    buffers.emplace_back(std::make_unique<CpuThreadEventBuffer>(index));
+    buffers.back()->threadName = "Thread " + std::to_string(index);
+
+    return buffers.back().get();
+}
+
+CpuThreadEventBuffer * CpuProfiler::threadBuffer() {
+    /// Buffers are owned by profiler and outlive their threads, so events of finished workers can still be exported
+    thread_local CpuThreadEventBuffer * buffer = nullptr;
+
+    if (!buffer) {
+        buffer = registerThread();
+    }
+
+    return buffer;
+}
+
+void CpuProfiler::setThreadName(const std::string & name) {
+    auto buffer = threadBuffer();
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+void CpuProfiler::beginFrame() {
+    uint64_t time = now();
+    uint64_t previous = frameStart.exchange(time, std::memory_order_acq_rel);
+
+    if (previous != 0) {
+        lastFrameStart.store(previous, std::memory_order_release);
+        lastFrameEnd.store(time, std::memory_order_release);
+    }
+}
+
+void CpuProfiler::collect(const uint64_t & from, const uint64_t & to, std::vector<CpuProfileEvent> & out) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    for (auto & buffer : buffers) {
+        uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > CpuThreadEventBuffer::CAPACITY ? end - CpuThreadEventBuffer::CAPACITY : 0;
+
+        CpuProfileEvent event;
+
+        /// Owning thread keeps writing - slots it overwrites meanwhile are skipped instead of torn
+        for (uint64_t i = begin; i < end; i++) {
+            if (!buffer->read(i, event)) continue;
+
+            if (event.end >= from && event.start <= to) {
+                out.push_back(event);
+            }
+        }
+    }
+}
+
+std::vector<std::string> CpuProfiler::getThreadNames() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::vector<std::string> names;
+
+    for (auto & buffer : buffers) {
+        names.push_back(buffer->threadName);
+    }
+
+    return names;
+}
+
+bool CpuProfiler::exportChromeTrace(const std::string & path) {
+    std::ofstream file(path);
+
+    if (!file.is_open()) {
+        std::cerr << "CpuProfiler: Could not open " << path << std::endl;
+        return false;
+    }
+
+    std::vector<CpuProfileEvent> events;
+    collect(0, now(), events);
+
+    auto threadNames = getThreadNames();
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    const char * separator = "\n";
+
+    for (size_t i = 0; i < threadNames.size(); i++) {
+        file << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+             << ",\"args\":{\"name\":\"" << threadNames[i] << "\"}}";
+        separator = ",\n";
+    }
+
+    file.precision(3);
+    file << std::fixed;
+
+    for (auto & event : events) {
+        file << separator << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex
+             << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+             << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0
+             << "}";
+        separator = ",\n";
+    }
+
+    file << "\n]}\n";
+
+    std::cout << "CpuProfiler: Exported " << events.size() << " events to " << path << std::endl;
+
+    return true;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Single completed zone. Name must point to a string with static storage (string literal)
+struct CpuProfileEvent {
+    const char * name = nullptr;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint32_t threadIndex = 0;
+    uint32_t depth = 0;
+};
+
+/// Ring slot guarded by sequence lock. Sequence is 2 * index + 1 while event with given write index is being
+/// written and 2 * index + 2 once it is complete, so reader detects both torn and overwritten slots.
+/// Fields are relaxed atomics, reading a slot which is being overwritten is not a data race.
+struct CpuEventSlot {
+    std::atomic<uint64_t> sequence { 0 };
+    std::atomic<const char *> name { nullptr };
+    std::atomic<uint64_t> start { 0 };
+    std::atomic<uint64_t> end { 0 };
+    std::atomic<uint32_t> depth { 0 };
+};
+
+/// Ring of events written by exactly one thread and read by any other.
+/// Writer publishes with release store of writeIndex, readers acquire it - no locks on the hot path.
+class CpuThreadEventBuffer {
+
+    public:
+
+        static const uint64_t CAPACITY = 1u << 16u;
+
+        std::string threadName;
+        uint32_t threadIndex = 0;
+        uint32_t depth = 0;
+
+        std::unique_ptr<CpuEventSlot[]> events;
+        std::atomic<uint64_t> writeIndex { 0 };
+
+        explicit CpuThreadEventBuffer(const uint32_t & index) : threadIndex(index), events(new CpuEventSlot[CAPACITY]) {}
+
+        void push(const CpuProfileEvent & event) {
+            uint64_t idx = writeIndex.load(std::memory_order_relaxed);
+            CpuEventSlot & slot = events[idx & (CAPACITY - 1)];
+
+            slot.sequence.store(2 * idx + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.name.store(event.name, std::memory_order_relaxed);
+            slot.start.store(event.start, std::memory_order_relaxed);
+            slot.end.store(event.end, std::memory_order_relaxed);
+            slot.depth.store(event.depth, std::memory_order_relaxed);
+
+            slot.sequence.store(2 * idx + 2, std::memory_order_release);
+            writeIndex.store(idx + 1, std::memory_order_release);
+        }
+
+        /// Copies event with given write index, fails when it is being written or was already overwritten
+        bool read(const uint64_t & idx, CpuProfileEvent & event) const {
+            const CpuEventSlot & slot = events[idx & (CAPACITY - 1)];
+
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+            if (sequence != 2 * idx + 2) return false;
+
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.end = slot.end.load(std::memory_order_relaxed);
+            event.depth = slot.depth.load(std::memory_order_relaxed);
+            event.threadIndex = threadIndex;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            return slot.sequence.load(std::memory_order_relaxed) == sequence;
+        }
+};
+
+class CpuProfiler {
+
+    private:
+
+        std::chrono::steady_clock::time_point epoch;
+
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<CpuThreadEventBuffer>> buffers;
+
+        std::atomic<uint64_t> frameStart { 0 };
+        std::atomic<uint64_t> lastFrameStart { 0 };
+        std::atomic<uint64_t> lastFrameEnd { 0 };
+
+        CpuThreadEventBuffer * registerThread();
+
+        CpuProfiler() : epoch(std::chrono::steady_clock::now()) {}
+
+    public:
+
+        std::atomic<bool> enabled { true };
+
+        static CpuProfiler & Instance() {
+            static CpuProfiler instance;
+            return instance;
+        }
+
+        CpuProfiler(CpuProfiler const &) = delete;
+
+        void operator=(CpuProfiler const &) = delete;
+
+        /// Nanoseconds since profiler creation
+        uint64_t now() const {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+        }
+
+        CpuThreadEventBuffer * threadBuffer();
+
+        void setThreadName(const std::string & name);
+
+        /// Marks frame boundary, previous frame becomes available for timeline view
+        void beginFrame();
+
+        uint64_t getLastFrameStart() const { return lastFrameStart.load(std::memory_order_acquire); }
+
+        uint64_t getLastFrameEnd() const { return lastFrameEnd.load(std::memory_order_acquire); }
+
+        /// Copies events overlapping [from, to] from all threads
+        void collect(const uint64_t & from, const uint64_t & to, std::vector<CpuProfileEvent> & out);
+
+        std::vector<std::string> getThreadNames();
+
+        /// Writes every buffered event in Chrome trace event format (chrome://tracing, ui.perfetto.dev)
+        bool exportChromeTrace(const std::string & path);
+};
+
+/// RAII zone - prefer PROFILE_SCOPE macro, which compiles out without ENGINE_PROFILING
+class CpuProfilerScope {
+
+    private:
+
+        const char * name;
+        uint64_t start;
+        CpuThreadEventBuffer * buffer;
+
+    public:
+
+        explicit CpuProfilerScope(const char * zoneName) : name(zoneName), start(0), buffer(nullptr) {
+            auto & profiler = CpuProfiler::Instance();
+
+            if (!profiler.enabled.load(std::memory_order_relaxed)) return;
+
+            buffer = profiler.threadBuffer();
+            buffer->depth++;
+            start = profiler.now();
+        }
+
+        ~CpuProfilerScope() {
+            if (!buffer) return;
+
+            CpuProfileEvent event;
+            event.name = name;
+            event.start = start;
+            event.end = CpuProfiler::Instance().now();
+            event.threadIndex = buffer->threadIndex;
+            event.depth = --buffer->depth;
+
+            buffer->push(event);
+        }
+
+        CpuProfilerScope(CpuProfilerScope const &) = delete;
+
+        void operator=(CpuProfilerScope const &) = delete;
+};
@@ -0,0 +1,177 @@
+#include "GpuProfiler.h"
+
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+void GpuZoneHistory::push(const float & value) {
+    samples[offset] = value;
+    offset = (offset + 1) % SIZE;
+    count = count < SIZE ? count + 1 : SIZE;
+    last = value;
+
+    min = std::numeric_limits<float>::max();
+    max = 0.0f;
+
+    float sum = 0.0f;
+
+    for (int i = 0; i < count; i++) {
+        min = samples[i] < min ? samples[i] : min;
+        max = samples[i] > max ? samples[i] : max;
+        sum += samples[i];
+    }
+
+    average = sum / static_cast<float>(count);
+}
+
+GLuint GpuProfiler::acquireQuery(FrameSlot & slot) {
+    if (slot.usedQueries == slot.queryPool.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        slot.queryPool.push_back(query);
+    }
+
+    return slot.queryPool[slot.usedQueries++];
+}
+
+void GpuProfiler::beginFrame() {
+    if (!enabled) return;
+
+    currentSlot = static_cast<int>(frameIndex % FRAME_LATENCY);
+
+    FrameSlot & slot = slots[currentSlot];
+
+    /// Slot is reused - collect results issued FRAME_LATENCY frames ago
+    if (slot.pending) {
+        resolve(slot);
+    }
+
+    slot.zones.clear();
+    slot.usedQueries = 0;
+    slot.frameIndex = frameIndex;
+    slot.pending = false;
+
+    openZones.clear();
+    frameOpen = true;
+}
+
+void GpuProfiler::endFrame() {
+    if (!enabled || !frameOpen) return;
+
+    while (!openZones.empty()) {
+        endZone();
+    }
+
+    slots[currentSlot].pending = !slots[currentSlot].zones.empty();
+
+    frameOpen = false;
+    frameIndex++;
+}
+
+void GpuProfiler::beginZone(const std::string & name) {
+    if (!enabled || !frameOpen) return;
+
+    FrameSlot & slot = slots[currentSlot];
+
+    Zone zone;
+    zone.name = openZones.empty() ? name : slot.zones[openZones.back()].name + "/" + name;
+    zone.depth = static_cast<int>(openZones.size());
+    zone.beginQuery = acquireQuery(slot);
+
+    glQueryCounter(zone.beginQuery, GL_TIMESTAMP);
+
+    openZones.push_back(static_cast<int>(slot.zones.size()));
+    slot.zones.push_back(zone);
+}
+
+void GpuProfiler::endZone() {
+    if (!enabled || !frameOpen || openZones.empty()) return;
+
+    FrameSlot & slot = slots[currentSlot];
+
+    Zone & zone = slot.zones[openZones.back()];
+    zone.endQuery = acquireQuery(slot);
+
+    glQueryCounter(zone.endQuery, GL_TIMESTAMP);
+
+    openZones.pop_back();
+}
+
+void GpuProfiler::resolve(FrameSlot & slot) {
+    slot.pending = false;
+
+    /// Queries complete in order, so availability of the last issued one implies all of them.
+    /// It is not the end query of the last zone - outer zones end after nested ones.
+    GLint available = 0;
+    glGetQueryObjectiv(slot.queryPool[slot.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available) {
+        droppedFrames++;
+        return;
+    }
+
+    lastResults.clear();
+
+    for (auto & zone : slot.zones) {
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+
+        glGetQueryObjectui64v(zone.beginQuery, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(zone.endQuery, GL_QUERY_RESULT, &end);
+
+        GpuZoneResult result;
+        result.name = zone.name;
+        result.depth = zone.depth;
+        result.milliseconds = end > begin ? static_cast<double>(end - begin) / 1000000.0 : 0.0;
+
+        histories[zone.name].push(static_cast<float>(result.milliseconds));
+
+        lastResults.push_back(result);
+    }
+
+    resolvedFrameIndex = slot.frameIndex;
+}
+
+bool GpuProfiler::dump(const std::string & path) const {
+    std::ofstream file(path);
+
+    if (!file.is_open()) {
+        std::cerr << "GpuProfiler: Could not open " << path << std::endl;
+        return false;
+    }
+
+    file << "{\n";
+    file << "  \"frame\": " << resolvedFrameIndex << ",\n";
+    file << "  \"droppedFrames\": " << droppedFrames << ",\n";
+    file << "  \"zones\": [\n";
+
+    for (size_t i = 0; i < lastResults.size(); i++) {
+        auto & result = lastResults[i];
+        auto & history = histories.at(result.name);
+
+        file << "    { \"name\": \"" << result.name << "\""
+             << ", \"depth\": " << result.depth
+             << ", \"ms\": " << result.milliseconds
+             << ", \"min\": " << history.min
+             << ", \"avg\": " << history.average
+             << ", \"max\": " << history.max
+             << ", \"samples\": " << history.count
+             << " }" << (i + 1 < lastResults.size() ? "," : "") << "\n";
+    }
+
+    file << "  ]\n";
+    file << "}\n";
+
+    return true;
+}
+
+void GpuProfiler::terminate() {
+    for (auto & slot : slots) {
+        if (!slot.queryPool.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(slot.queryPool.size()), slot.queryPool.data());
+        }
+        slot.queryPool.clear();
+        slot.zones.clear();
+        slot.pending = false;
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <glad.h>
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Timing of single GPU zone resolved from a pair of GL_TIMESTAMP queries
+struct GpuZoneResult {
+    std::string name;
+    int depth = 0;
+    double milliseconds = 0.0;
+};
+
+/// Rolling history of one zone, used by editor graph
+struct GpuZoneHistory {
+    static const int SIZE = 240;
+
+    std::array<float, SIZE> samples {};
+    int offset = 0;
+    int count = 0;
+
+    float last = 0.0f;
+    float min = 0.0f;
+    float max = 0.0f;
+    float average = 0.0f;
+
+    void push(const float & value);
+};
+
+class GpuProfiler {
+
+    private:
+
+        /// Number of frames in flight - results are read FRAME_LATENCY frames after they were issued,
+        /// so the driver has finished them and reading never stalls the pipeline
+        static const int FRAME_LATENCY = 4;
+
+        struct Zone {
+            std::string name;
+            int depth = 0;
+            GLuint beginQuery = 0;
+            GLuint endQuery = 0;
+        };
+
+        struct FrameSlot {
+            std::vector<Zone> zones;
+            std::vector<GLuint> queryPool;
+            unsigned int usedQueries = 0;
+            unsigned long long frameIndex = 0;
+            bool pending = false;
+        };
+
+        std::array<FrameSlot, FRAME_LATENCY> slots;
+
+        std::vector<int> openZones;
+
+        unsigned long long frameIndex = 0;
+        unsigned long long resolvedFrameIndex = 0;
+        unsigned long long droppedFrames = 0;
+
+        int currentSlot = 0;
+
+        bool frameOpen = false;
+
+        std::vector<GpuZoneResult> lastResults;
+
+        std::map<std::string, GpuZoneHistory> histories;
+
+        GLuint acquireQuery(FrameSlot & slot);
+
+        void resolve(FrameSlot & slot);
+
+        GpuProfiler() = default;
+
+    public:
+
+        bool enabled = true;
+
+        static GpuProfiler & Instance() {
+            static GpuProfiler instance;
+            return instance;
+        }
+
+        GpuProfiler(GpuProfiler const &) = delete;
+
+        void operator=(GpuProfiler const &) = delete;
+
+        void beginFrame();
+
+        void endFrame();
+
+        void beginZone(const std::string & name);
+
+        void endZone();
+
+        const std::vector<GpuZoneResult> & getLastResults() const { return lastResults; }
+
+        const std::map<std::string, GpuZoneHistory> & getHistories() const { return histories; }
+
+        unsigned long long getResolvedFrameIndex() const { return resolvedFrameIndex; }
+
+        unsigned long long getDroppedFrames() const { return droppedFrames; }
+
+        /// Writes last resolved frame and per zone statistics as JSON
+        bool dump(const std::string & path) const;
+
+        void terminate();
+};
+
+/// Measures GPU time of enclosing scope
+class GpuProfilerScope {
+    public:
+        explicit GpuProfilerScope(const std::string & name) {
+            GpuProfiler::Instance().beginZone(name);
+        }
+
+        ~GpuProfilerScope() {
+            GpuProfiler::Instance().endZone();
+        }
+};
@@ -0,0 +1,81 @@
+#include "MemoryTracker.h"
+
+#include <fstream>
+#include <iostream>
+
+const char * MemoryTracker::name(const MemoryCategory & category) {
+    switch (category) {
+        case MemoryCategory::MESH_GEOMETRY: return "Mesh geometry";
+        case MemoryCategory::INSTANCE_DATA: return "Instance data";
+        case MemoryCategory::COMPONENT_POOLS: return "Component pools";
+        case MemoryCategory::GPU_GEOMETRY: return "GPU geometry";
+        case MemoryCategory::GPU_INSTANCE_BUFFERS: return "GPU instance buffers";
+        case MemoryCategory::GPU_TEXTURES: return "GPU textures";
+        case MemoryCategory::GPU_RENDER_TARGETS: return "GPU render targets";
+        case MemoryCategory::COUNT: break;
+    }
+
+    return "Unknown";
+}
+
+MemoryCategoryStats MemoryTracker::getStats(const MemoryCategory & category) const {
+    auto & counter = counters[static_cast<int>(category)];
+
+    MemoryCategoryStats stats;
+    stats.current = counter.current.load(std::memory_order_relaxed);
+    stats.peak = counter.peak.load(std::memory_order_relaxed);
+    stats.allocations = counter.allocations.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+int64_t MemoryTracker::getTotal(const bool & gpu) const {
+    int64_t total = 0;
+
+    for (int i = 0; i < static_cast<int>(MemoryCategory::COUNT); i++) {
+        if (isGpu(static_cast<MemoryCategory>(i)) == gpu) {
+            total += counters[i].current.load(std::memory_order_relaxed);
+        }
+    }
+
+    return total;
+}
+
+void MemoryTracker::resetPeaks() {
+    for (auto & counter : counters) {
+        counter.peak.store(counter.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+bool MemoryTracker::dump(const std::string & path) const {
+    std::ofstream file(path);
+
+    if (!file.is_open()) {
+        std::cerr << "MemoryTracker: Could not open " << path << std::endl;
+        return false;
+    }
+
+    file << "{\n";
+    file << "  \"cpuBytes\": " << getTotal(false) << ",\n";
+    file << "  \"gpuBytes\": " << getTotal(true) << ",\n";
+    file << "  \"categories\": [\n";
+
+    int count = static_cast<int>(MemoryCategory::COUNT);
+
+    for (int i = 0; i < count; i++) {
+        auto category = static_cast<MemoryCategory>(i);
+        auto stats = getStats(category);
+
+        file << "    { \"name\": \"" << name(category) << "\""
+             << ", \"gpu\": " << (isGpu(category) ? "true" : "false")
+             << ", \"bytes\": " << stats.current
+             << ", \"peakBytes\": " << stats.peak
+             << ", \"allocations\": " << stats.allocations
+             << " }" << (i + 1 < count ? "," : "") << "\n";
+    }
+
+    file << "  ]\n";
+    file << "}\n";
+
+    return true;
+}
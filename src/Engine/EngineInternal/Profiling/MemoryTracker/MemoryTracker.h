@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class MemoryCategory {
+    /// Vertices, indices, uvs and normals owned by meshes (mapped cooked files are not counted)
+    MESH_GEOMETRY,
+    /// Model matrices and colors of instances, including per frame copies of visible ones
+    INSTANCE_DATA,
+    /// Chunks of ObjectPool and BlockPool, never returned
+    COMPONENT_POOLS,
+    /// Vertex, uv, normal and index buffers
+    GPU_GEOMETRY,
+    /// Model matrix and color buffers of instances
+    GPU_INSTANCE_BUFFERS,
+    /// Mesh textures and cube maps
+    GPU_TEXTURES,
+    /// Color textures and depth renderbuffers of scene framebuffers
+    GPU_RENDER_TARGETS,
+    COUNT
+};
+
+/// Current size, high-water mark and allocation count of one category
+struct MemoryCategoryStats {
+    int64_t current = 0;
+    int64_t peak = 0;
+    uint64_t allocations = 0;
+};
+
+/// Bytes used per category, reported by owners of allocations.
+///
+/// Counting is cheap (few relaxed atomics), so it is always on - totals are meant for setting memory budgets.
+/// GPU sizes are computed from dimensions and formats, driver padding and mipmaps are not included.
+class MemoryTracker {
+
+    private:
+
+        struct Counter {
+            std::atomic<int64_t> current { 0 };
+            std::atomic<int64_t> peak { 0 };
+            std::atomic<uint64_t> allocations { 0 };
+        };
+
+        Counter counters[static_cast<int>(MemoryCategory::COUNT)];
+
+        MemoryTracker() = default;
+
+    public:
+
+        /// Never destroyed - pools and meshes released during static destruction still report here
+        static MemoryTracker & Instance() {
+            static MemoryTracker * instance = new MemoryTracker();
+            return *instance;
+        }
+
+        MemoryTracker(MemoryTracker const &) = delete;
+
+        void operator=(MemoryTracker const &) = delete;
+
+        static const char * name(const MemoryCategory & category);
+
+        static bool isGpu(const MemoryCategory & category) { return category >= MemoryCategory::GPU_GEOMETRY; }
+
+        void add(const MemoryCategory & category, const size_t & bytes) {
+            auto & counter = counters[static_cast<int>(category)];
+
+            int64_t current = counter.current.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+            int64_t peak = counter.peak.load(std::memory_order_relaxed);
+
+            while (current > peak && !counter.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+
+            counter.allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void remove(const MemoryCategory & category, const size_t & bytes) {
+            counters[static_cast<int>(category)].current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+        }
+
+        /// Moves allocation previously reported as tracked bytes to its new size, tracked is updated
+        void update(const MemoryCategory & category, size_t & tracked, const size_t & bytes) {
+            if (bytes > tracked) {
+                add(category, bytes - tracked);
+            }
+            else if (bytes < tracked) {
+                remove(category, tracked - bytes);
+            }
+
+            tracked = bytes;
+        }
+
+        MemoryCategoryStats getStats(const MemoryCategory & category) const;
+
+        /// Sum of current sizes of CPU or GPU categories
+        int64_t getTotal(const bool & gpu) const;
+
+        /// Forgets high-water marks, they restart from current sizes
+        void resetPeaks();
+
+        /// Writes all categories as JSON
+        bool dump(const std::string & path) const;
+};
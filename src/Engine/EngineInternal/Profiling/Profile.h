@@ -0,0 +1,24 @@
+#pragma once
+
+/// Profiling zones. Build with -DENGINE_PROFILING=OFF to compile all of them out.
+
+#ifdef ENGINE_PROFILING
+
+#include <Profiling/CpuProfiler/CpuProfiler.h>
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#define PROFILE_SCOPE(name) CpuProfilerScope ENGINE_PROFILE_CONCAT(profilerScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_FRAME() CpuProfiler::Instance().beginFrame()
+#define PROFILE_THREAD(name) CpuProfiler::Instance().setThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME()
+#define PROFILE_THREAD(name)
+
+#endif
@@ -2,7 +2,9 @@
 
 #include <glm/glm/vec3.hpp>
 
+/// Object space bounds of object's mesh, bounding sphere is centered at box center
 struct BoundingBox {
     glm::vec3 size;
     glm::vec3 center;
-};
\ No newline at end of file
+    float radius = 0.0f;
+};
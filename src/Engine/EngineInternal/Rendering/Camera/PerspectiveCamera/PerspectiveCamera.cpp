@@ -1,5 +1,7 @@
 #include "PerspectiveCamera.h"
 
+#include <Engine/EngineInternal/Time.h>
+
 PerspectiveCamera::PerspectiveCamera(const glm::vec3 position) : BaseCamera() {
     positionProperty = std::make_shared<Vec3Property>(position);
     lookDirectionVector = normalize(lookAt - position);
@@ -75,10 +77,7 @@ void PerspectiveCamera::onKeyInfoReceived(const KeyInfo & keyInfo) {
 void PerspectiveCamera::Update() {
 
     calculateFrustumPlanes();
-    currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
-    positionProperty->setValue(getPosition() + velocity * deltaTime);
+    positionProperty->setValue(getPosition() + velocity * Time::Instance().getDeltaTime());
 }
 
 void PerspectiveCamera::updateAspectRatio(const glm::vec2 & size) {
@@ -103,33 +102,6 @@ glm::mat4x4 PerspectiveCamera::getProjectionMatrix() {
     return glm::perspective(glm::radians(fovy), aspectRatio, 0.1f, 10000.0f);
 }
 
-bool PerspectiveCamera::testFrustum(const std::shared_ptr<GameObjectBase> & child) {
-
-    glm::vec3 center = child->transform.position;
-
-    auto bBox = child->boundingBox;
-
-    float radius;
-
-    if (!bBox.get()) {
-        radius = std::max(std::max(child->transform.scale.x, child->transform.scale.y), child->transform.scale.z);
-    }
-    else {
-        radius = std::max(std::max(bBox->transform.scale.x, bBox->transform.scale.y), bBox->transform.scale.z);
-    }
-
-    for (int i = 5; i >= 0; i--) {
-        float dist = planes[i].x * center.x + planes[i].y * center.y + planes[i].z * center.z + planes[i].w - radius;
-
-        if (dist < - radius * 2.0f) {
-            child->culled = true;
-            return false;
-        }
-    }
-    child->culled = false;
-    return true;
-}
-
 void PerspectiveCamera::calculateFrustumPlanes() {
     glm::mat matrix = glm::perspective(glm::radians(fovy), aspectRatio, 0.1f, 100.0f) * getViewMatrix();
 
@@ -2,6 +2,8 @@
 
 #include "Engine/EngineInternal/Rendering/Camera/BaseCamera.h"
 
+#include <array>
+
 enum Plane {
     Right = 0,
     Left,
@@ -11,11 +13,13 @@ enum Plane {
     Near
 };
 
+typedef std::array<glm::vec4, 6> FrustumPlanes;
+
 class PerspectiveCamera : public BaseCamera {
 
     private:
 
-        glm::vec4 planes[6];
+        FrustumPlanes planes;
 
         glm::vec3 lookDirectionVector = glm::vec3(0.0, 0.0, 0.0);
         glm::vec3 frontVector = glm::vec3(0.0, 0.0, -1.0);
@@ -35,10 +39,6 @@ class PerspectiveCamera : public BaseCamera {
 
         float aspectRatio = 1.0;
 
-        float currentFrame = 0.0f;
-        float deltaTime = 0.0f;
-        float lastFrame = 0.0f;
-
         PerspectiveCamera(const glm::vec3 position);
 
         void onMouseMove(const glm::vec2 & delta) override;
@@ -56,5 +56,5 @@ class PerspectiveCamera : public BaseCamera {
 
         void calculateFrustumPlanes();
 
-        bool testFrustum(const std::shared_ptr<GameObjectBase> & child);
+        const FrustumPlanes & getFrustumPlanes() const { return planes; }
 };
\ No newline at end of file
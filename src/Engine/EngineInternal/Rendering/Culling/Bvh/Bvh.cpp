@@ -0,0 +1,544 @@
+#include "Bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace {
+
+    BvhAabb expanded(const BvhAabb & box, const float & amount) {
+        BvhAabb result;
+        result.min = box.min - glm::vec3(amount);
+        result.max = box.max + glm::vec3(amount);
+        return result;
+    }
+
+    /// Distance along ray to box entry point, negative when ray misses box
+    float rayBoxDistance(const glm::vec3 & origin, const glm::vec3 & inverseDirection, const BvhAabb & box, const float & maxDistance) {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int axis = 0; axis < 3; axis++) {
+            float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+            float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+
+        return tMin <= tMax ? tMin : -1.0f;
+    }
+
+    float pointBoxDistance(const glm::vec3 & point, const BvhAabb & box) {
+        glm::vec3 d = glm::max(glm::max(box.min - point, point - box.max), glm::vec3(0.0f));
+        return std::sqrt(d.x * d.x + d.y * d.y + d.z * d.z);
+    }
+}
+
+int Bvh::allocateNode() {
+    int index;
+
+    if (freeList == NULL_NODE) {
+        nodes.emplace_back();
+        index = static_cast<int>(nodes.size()) - 1;
+    }
+    else {
+        index = freeList;
+        freeList = nodes[index].parent;
+    }
+
+    Node & node = nodes[index];
+    node.parent = NULL_NODE;
+    node.left = NULL_NODE;
+    node.right = NULL_NODE;
+    node.height = 0;
+    node.userData = 0;
+
+    return index;
+}
+
+void Bvh::freeNode(const int & index) {
+    nodes[index].parent = freeList;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+int Bvh::insert(const BvhAabb & box, const uint32_t & userData) {
+    int leaf = allocateNode();
+
+    nodes[leaf].box = expanded(box, margin);
+    nodes[leaf].userData = userData;
+
+    insertLeaf(leaf);
+    leafCount++;
+
+    return leaf;
+}
+
+void Bvh::remove(const int & proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    leafCount--;
+}
+
+bool Bvh::move(const int & proxy, const BvhAabb & box) {
+    const BvhAabb & fatBox = nodes[proxy].box;
+
+    /// Reinsert also when object shrank a lot, so enlarged box stays tight enough for culling
+    if (fatBox.contains(box) && expanded(box, 4.0f * margin).contains(fatBox)) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    nodes[proxy].box = expanded(box, margin);
+    insertLeaf(proxy);
+
+    return true;
+}
+
+void Bvh::clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    leafCount = 0;
+}
+
+void Bvh::insertLeaf(const int & leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    /// Descend towards child with lowest surface area increase
+    BvhAabb leafBox = nodes[leaf].box;
+
+    int index = root;
+
+    while (!nodes[index].isLeaf()) {
+        const Node & node = nodes[index];
+
+        float area = node.box.surfaceArea();
+        float combinedArea = BvhAabb::merge(node.box, leafBox).surfaceArea();
+
+        /// Cost of creating new parent for this node and the leaf
+        float cost = 2.0f * combinedArea;
+
+        /// Minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](const int & child) {
+            const Node & childNode = nodes[child];
+            float mergedArea = BvhAabb::merge(childNode.box, leafBox).surfaceArea();
+
+            if (childNode.isLeaf()) {
+                return mergedArea + inheritanceCost;
+            }
+
+            return mergedArea - childNode.box.surfaceArea() + inheritanceCost;
+        };
+
+        float leftCost = descendCost(node.left);
+        float rightCost = descendCost(node.right);
+
+        if (cost < leftCost && cost < rightCost) {
+            break;
+        }
+
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    int sibling = index;
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = BvhAabb::merge(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].left = sibling;
+    nodes[newParent].right = leaf;
+
+    if (oldParent != NULL_NODE) {
+        if (nodes[oldParent].left == sibling) {
+            nodes[oldParent].left = newParent;
+        }
+        else {
+            nodes[oldParent].right = newParent;
+        }
+    }
+    else {
+        root = newParent;
+    }
+
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    refitFrom(nodes[leaf].parent);
+}
+
+void Bvh::removeLeaf(const int & leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    if (grandParent != NULL_NODE) {
+        if (nodes[grandParent].left == parent) {
+            nodes[grandParent].left = sibling;
+        }
+        else {
+            nodes[grandParent].right = sibling;
+        }
+
+        nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refitFrom(grandParent);
+    }
+    else {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+void Bvh::refitFrom(int index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node & node = nodes[index];
+        const Node & left = nodes[node.left];
+        const Node & right = nodes[node.right];
+
+        node.height = 1 + std::max(left.height, right.height);
+        node.box = BvhAabb::merge(left.box, right.box);
+
+        index = node.parent;
+    }
+}
+
+int Bvh::balance(const int & iA) {
+    Node & a = nodes[iA];
+
+    if (a.isLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    int iB = a.left;
+    int iC = a.right;
+
+    Node & b = nodes[iB];
+    Node & c = nodes[iC];
+
+    int difference = c.height - b.height;
+
+    /// Rotate right child up
+    if (difference > 1) {
+        int iF = c.left;
+        int iG = c.right;
+
+        Node & f = nodes[iF];
+        Node & g = nodes[iG];
+
+        c.left = iA;
+        c.parent = a.parent;
+        a.parent = iC;
+
+        if (c.parent != NULL_NODE) {
+            if (nodes[c.parent].left == iA) {
+                nodes[c.parent].left = iC;
+            }
+            else {
+                nodes[c.parent].right = iC;
+            }
+        }
+        else {
+            root = iC;
+        }
+
+        if (f.height > g.height) {
+            c.right = iF;
+            a.right = iG;
+            g.parent = iA;
+
+            a.box = BvhAabb::merge(b.box, g.box);
+            c.box = BvhAabb::merge(a.box, f.box);
+
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else {
+            c.right = iG;
+            a.right = iF;
+            f.parent = iA;
+
+            a.box = BvhAabb::merge(b.box, f.box);
+            c.box = BvhAabb::merge(a.box, g.box);
+
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+
+        return iC;
+    }
+
+    /// Rotate left child up
+    if (difference < -1) {
+        int iD = b.left;
+        int iE = b.right;
+
+        Node & d = nodes[iD];
+        Node & e = nodes[iE];
+
+        b.left = iA;
+        b.parent = a.parent;
+        a.parent = iB;
+
+        if (b.parent != NULL_NODE) {
+            if (nodes[b.parent].left == iA) {
+                nodes[b.parent].left = iB;
+            }
+            else {
+                nodes[b.parent].right = iB;
+            }
+        }
+        else {
+            root = iB;
+        }
+
+        if (d.height > e.height) {
+            b.right = iD;
+            a.left = iE;
+            e.parent = iA;
+
+            a.box = BvhAabb::merge(c.box, e.box);
+            b.box = BvhAabb::merge(a.box, d.box);
+
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else {
+            b.right = iE;
+            a.left = iD;
+            d.parent = iA;
+
+            a.box = BvhAabb::merge(c.box, d.box);
+            b.box = BvhAabb::merge(a.box, e.box);
+
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+void Bvh::collectLeaves(const int & index, std::vector<uint32_t> & out) const {
+    std::vector<int> stack;
+    stack.push_back(index);
+
+    while (!stack.empty()) {
+        const Node & node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            out.push_back(node.userData);
+        }
+        else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+void Bvh::queryAabb(const BvhAabb & box, std::vector<uint32_t> & out) const {
+    if (root == NULL_NODE) return;
+
+    std::vector<int> stack;
+    stack.push_back(root);
+
+    while (!stack.empty()) {
+        const Node & node = nodes[stack.back()];
+        stack.pop_back();
+
+        if (!node.box.overlaps(box)) continue;
+
+        if (node.isLeaf()) {
+            out.push_back(node.userData);
+        }
+        else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+void Bvh::queryFrustum(const glm::vec4 * planes, std::vector<uint32_t> & out) const {
+    if (root == NULL_NODE) return;
+
+    const unsigned int allPlanes = 0x3F;
+
+    /// Node index and planes its parent was not fully inside of
+    std::vector<std::pair<int, unsigned int>> stack;
+    stack.emplace_back(root, allPlanes);
+
+    while (!stack.empty()) {
+        auto [index, mask] = stack.back();
+        stack.pop_back();
+
+        const Node & node = nodes[index];
+
+        glm::vec3 center = node.box.center();
+        glm::vec3 extent = node.box.extent();
+
+        bool outside = false;
+
+        for (unsigned int i = 0; i < 6; i++) {
+            if (!(mask & (1u << i))) continue;
+
+            const glm::vec4 & plane = planes[i];
+
+            float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            float radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y + std::abs(plane.z) * extent.z;
+
+            if (distance + radius < 0.0f) {
+                outside = true;
+                break;
+            }
+
+            /// Box is on inner side of this plane, descendants do not need to test it
+            if (distance - radius >= 0.0f) {
+                mask &= ~(1u << i);
+            }
+        }
+
+        if (outside) continue;
+
+        if (node.isLeaf()) {
+            out.push_back(node.userData);
+        }
+        else if (mask == 0) {
+            collectLeaves(index, out);
+        }
+        else {
+            stack.emplace_back(node.left, mask);
+            stack.emplace_back(node.right, mask);
+        }
+    }
+}
+
+bool Bvh::raycast(const glm::vec3 & origin, const glm::vec3 & direction, const float & maxDistance, BvhRayHit & hit,
+                  const std::function<float(uint32_t, float)> & hitTest) const {
+    if (root == NULL_NODE) return false;
+
+    glm::vec3 inverseDirection = glm::vec3(1.0f) / direction;
+
+    float closest = maxDistance;
+    bool found = false;
+
+    float rootDistance = rayBoxDistance(origin, inverseDirection, nodes[root].box, closest);
+
+    if (rootDistance < 0.0f) return false;
+
+    /// Node index and distance to its box entry
+    std::vector<std::pair<int, float>> stack;
+    stack.emplace_back(root, rootDistance);
+
+    while (!stack.empty()) {
+        auto [index, entry] = stack.back();
+        stack.pop_back();
+
+        if (entry > closest) continue;
+
+        const Node & node = nodes[index];
+
+        if (node.isLeaf()) {
+            float distance = hitTest ? hitTest(node.userData, entry) : entry;
+
+            if (distance >= 0.0f && distance <= closest) {
+                closest = distance;
+                hit.userData = node.userData;
+                hit.distance = distance;
+                found = true;
+            }
+
+            continue;
+        }
+
+        float leftDistance = rayBoxDistance(origin, inverseDirection, nodes[node.left].box, closest);
+        float rightDistance = rayBoxDistance(origin, inverseDirection, nodes[node.right].box, closest);
+
+        /// Push farther child first, so nearer one is visited first and can shrink search distance
+        bool leftFirst = leftDistance >= 0.0f && (rightDistance < 0.0f || leftDistance <= rightDistance);
+
+        if (leftFirst) {
+            if (rightDistance >= 0.0f) stack.emplace_back(node.right, rightDistance);
+            stack.emplace_back(node.left, leftDistance);
+        }
+        else {
+            if (leftDistance >= 0.0f) stack.emplace_back(node.left, leftDistance);
+            if (rightDistance >= 0.0f) stack.emplace_back(node.right, rightDistance);
+        }
+    }
+
+    return found;
+}
+
+void Bvh::nearest(const glm::vec3 & point, const size_t & k, std::vector<BvhNearest> & out) const {
+    if (root == NULL_NODE || k == 0) return;
+
+    typedef std::pair<float, int> Candidate;
+    typedef std::pair<float, uint32_t> Result;
+
+    /// Nodes ordered by distance (closest first) and best results found so far (farthest first)
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    std::priority_queue<Result> results;
+
+    candidates.emplace(pointBoxDistance(point, nodes[root].box), root);
+
+    while (!candidates.empty()) {
+        Candidate candidate = candidates.top();
+        candidates.pop();
+
+        if (results.size() == k && candidate.first > results.top().first) break;
+
+        const Node & node = nodes[candidate.second];
+
+        if (node.isLeaf()) {
+            results.emplace(candidate.first, node.userData);
+
+            if (results.size() > k) {
+                results.pop();
+            }
+
+            continue;
+        }
+
+        for (int child : { node.left, node.right }) {
+            float distance = pointBoxDistance(point, nodes[child].box);
+
+            if (results.size() < k || distance <= results.top().first) {
+                candidates.emplace(distance, child);
+            }
+        }
+    }
+
+    size_t first = out.size();
+
+    while (!results.empty()) {
+        BvhNearest entry;
+        entry.distance = results.top().first;
+        entry.userData = results.top().second;
+        out.push_back(entry);
+        results.pop();
+    }
+
+    std::reverse(out.begin() + first, out.end());
+}
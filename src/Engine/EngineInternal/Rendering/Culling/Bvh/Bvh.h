@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <glm/glm/glm.hpp>
+
+struct BvhAabb {
+    glm::vec3 min = glm::vec3(0.0f);
+    glm::vec3 max = glm::vec3(0.0f);
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+
+    glm::vec3 extent() const { return (max - min) * 0.5f; }
+
+    float surfaceArea() const {
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    bool contains(const BvhAabb & other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    bool overlaps(const BvhAabb & other) const {
+        return min.x <= other.max.x && min.y <= other.max.y && min.z <= other.max.z &&
+               max.x >= other.min.x && max.y >= other.min.y && max.z >= other.min.z;
+    }
+
+    static BvhAabb merge(const BvhAabb & a, const BvhAabb & b) {
+        BvhAabb result;
+        result.min = glm::min(a.min, b.min);
+        result.max = glm::max(a.max, b.max);
+        return result;
+    }
+};
+
+struct BvhRayHit {
+    uint32_t userData = 0;
+    float distance = 0.0f;
+};
+
+struct BvhNearest {
+    uint32_t userData = 0;
+
+    /// Distance from query point to proxy box, 0 when point is inside
+    float distance = 0.0f;
+};
+
+/// Dynamic bounding volume hierarchy of axis aligned boxes.
+///
+/// Leaves store boxes enlarged by margin, so objects moving inside them need no tree update.
+/// When object leaves its enlarged box, its leaf is reinserted - ancestors on old and new path are refitted
+/// and rebalanced with tree rotations, which keeps queries logarithmic without full rebuilds.
+class Bvh {
+
+    private:
+
+        struct Node {
+            BvhAabb box;
+
+            int parent = -1;
+            int left = -1;
+            int right = -1;
+
+            /// Leaves have height 0, free nodes -1
+            int height = -1;
+
+            uint32_t userData = 0;
+
+            bool isLeaf() const { return left == -1; }
+        };
+
+        std::vector<Node> nodes;
+
+        int root = -1;
+
+        /// Free nodes are chained through parent index
+        int freeList = -1;
+
+        size_t leafCount = 0;
+
+        int allocateNode();
+
+        void freeNode(const int & index);
+
+        void insertLeaf(const int & leaf);
+
+        void removeLeaf(const int & leaf);
+
+        void refitFrom(int index);
+
+        int balance(const int & index);
+
+        void collectLeaves(const int & index, std::vector<uint32_t> & out) const;
+
+    public:
+
+        static const int NULL_NODE = -1;
+
+        /// Enlargement of leaf boxes in world units
+        float margin = 0.1f;
+
+        /// Returns proxy id used for move and remove
+        int insert(const BvhAabb & box, const uint32_t & userData);
+
+        void remove(const int & proxy);
+
+        /// Returns true if proxy left its enlarged box and the tree was updated
+        bool move(const int & proxy, const BvhAabb & box);
+
+        void clear();
+
+        uint32_t getUserData(const int & proxy) const { return nodes[proxy].userData; }
+
+        const BvhAabb & getFatBox(const int & proxy) const { return nodes[proxy].box; }
+
+        size_t size() const { return leafCount; }
+
+        int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+        /// Appends user data of all proxies overlapping box
+        void queryAabb(const BvhAabb & box, std::vector<uint32_t> & out) const;
+
+        /// Appends user data of all proxies intersecting frustum given by six inward facing planes.
+        /// Subtrees fully inside the frustum are accepted without testing their children.
+        void queryFrustum(const glm::vec4 * planes, std::vector<uint32_t> & out) const;
+
+        /// Finds closest hit along ray. Optional hitTest refines box hit - it gets user data and distance
+        /// to proxy box and returns exact distance, or negative value when the object is missed.
+        bool raycast(const glm::vec3 & origin, const glm::vec3 & direction, const float & maxDistance, BvhRayHit & hit,
+                     const std::function<float(uint32_t, float)> & hitTest = nullptr) const;
+
+        /// Finds up to k proxies closest to point, sorted by distance
+        void nearest(const glm::vec3 & point, const size_t & k, std::vector<BvhNearest> & out) const;
+};
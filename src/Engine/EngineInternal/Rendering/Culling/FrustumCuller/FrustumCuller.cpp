@@ -0,0 +1,496 @@
+#include "FrustumCuller.h"
+
+#include <atomic>
+#include <cmath>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #include <immintrin.h>
+
+    #if defined(__GNUC__) || defined(__clang__)
+        /// Kernels are compiled for their instruction set regardless of global flags and picked at runtime
+        #define CULLER_TARGET(isa) __attribute__((target(isa)))
+        #define CULLER_SSE 1
+        #define CULLER_AVX2 1
+        #define CULLER_AVX512 1
+    #else
+        /// No per-function targets, only kernels enabled by compiler flags are available
+        #define CULLER_TARGET(isa)
+        #define CULLER_SSE 1
+
+        #if defined(__AVX2__)
+            #define CULLER_AVX2 1
+        #endif
+
+        #if defined(__AVX512F__)
+            #define CULLER_AVX512 1
+        #endif
+    #endif
+#endif
+
+namespace {
+
+    /// Plane test order when starting from given plane
+    const uint8_t planeOrder[6][6] = {
+        {0, 1, 2, 3, 4, 5},
+        {1, 2, 3, 4, 5, 0},
+        {2, 3, 4, 5, 0, 1},
+        {3, 4, 5, 0, 1, 2},
+        {4, 5, 0, 1, 2, 3},
+        {5, 0, 1, 2, 3, 4}
+    };
+
+    struct CullingStreams {
+        const float * cx;
+        const float * cy;
+        const float * cz;
+        const float * ex;
+        const float * ey;
+        const float * ez;
+        const float * r;
+
+        uint8_t * lastPlane;
+        unsigned char * visibility;
+    };
+
+    inline unsigned int lowestBit(const unsigned int & bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned int>(__builtin_ctz(bits));
+#else
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<unsigned int>(index);
+#endif
+    }
+
+    /// Stores rejecting plane for lanes that got rejected by it first, returns all rejected lanes
+    inline unsigned int recordRejected(unsigned int rejected, unsigned int outside, const uint8_t & plane, uint8_t * lastPlane) {
+        unsigned int newlyRejected = outside & ~rejected;
+
+        while (newlyRejected) {
+            lastPlane[lowestBit(newlyRejected)] = plane;
+            newlyRejected &= newlyRejected - 1;
+        }
+
+        return rejected | outside;
+    }
+
+    inline unsigned int countBits(unsigned int bits) {
+        unsigned int result = 0;
+
+        for (; bits; bits &= bits - 1) {
+            result++;
+        }
+
+        return result;
+    }
+
+    inline void writeVisibility(const unsigned int & rejected, const unsigned int & width, unsigned char * visibility) {
+        for (unsigned int lane = 0; lane < width; lane++) {
+            visibility[lane] = (rejected & (1u << lane)) ? 0 : 1;
+        }
+    }
+
+    size_t cullScalar(const CullingPlanes & p, const bool & sphere, const CullingStreams & s, const size_t & begin, const size_t & end) {
+        size_t visible = 0;
+
+        for (size_t i = begin; i < end; i++) {
+            const uint8_t * order = planeOrder[s.lastPlane[i]];
+
+            unsigned char inside = 1;
+
+            for (int k = 0; k < 6; k++) {
+                uint8_t plane = order[k];
+
+                float dist = p.x[plane] * s.cx[i] + p.y[plane] * s.cy[i] + p.z[plane] * s.cz[i] + p.w[plane];
+
+                float bound = sphere ? s.r[i] : p.absX[plane] * s.ex[i] + p.absY[plane] * s.ey[i] + p.absZ[plane] * s.ez[i];
+
+                if (dist + bound < 0.0f) {
+                    s.lastPlane[i] = plane;
+                    inside = 0;
+                    break;
+                }
+            }
+
+            s.visibility[i] = inside;
+            visible += inside;
+        }
+
+        return visible;
+    }
+
+#ifdef CULLER_SSE
+    struct BatchSSE {
+        __m128 cx, cy, cz;
+
+        /// Half extents, or radius in ex for sphere tests
+        __m128 ex, ey, ez;
+    };
+
+    CULLER_TARGET("sse2")
+    inline unsigned int outsideSSE(const BatchSSE & b, const bool & sphere,
+                                   const __m128 & px, const __m128 & py, const __m128 & pz, const __m128 & pw,
+                                   const __m128 & ax, const __m128 & ay, const __m128 & az) {
+        __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, b.cx), _mm_mul_ps(py, b.cy)),
+                                 _mm_add_ps(_mm_mul_ps(pz, b.cz), pw));
+
+        __m128 bound = sphere ? b.ex :
+                       _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, b.ex), _mm_mul_ps(ay, b.ey)), _mm_mul_ps(az, b.ez));
+
+        return static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(dist, bound), _mm_setzero_ps())));
+    }
+
+    CULLER_TARGET("sse2")
+    size_t cullSSE(const CullingPlanes & p, const bool & sphere, const CullingStreams & s, const size_t & begin, const size_t & end) {
+        const unsigned int all = 0xF;
+
+        size_t visible = 0;
+        size_t i = begin;
+
+        for (; i + 4 <= end; i += 4) {
+            BatchSSE b;
+            b.cx = _mm_loadu_ps(s.cx + i);
+            b.cy = _mm_loadu_ps(s.cy + i);
+            b.cz = _mm_loadu_ps(s.cz + i);
+
+            b.ex = _mm_loadu_ps(sphere ? s.r + i : s.ex + i);
+            b.ey = _mm_loadu_ps(s.ey + i);
+            b.ez = _mm_loadu_ps(s.ez + i);
+
+            /// Each lane first tests plane that rejected it last time
+            const uint8_t * last = s.lastPlane + i;
+
+            unsigned int rejected = outsideSSE(b, sphere,
+                    _mm_setr_ps(p.x[last[0]], p.x[last[1]], p.x[last[2]], p.x[last[3]]),
+                    _mm_setr_ps(p.y[last[0]], p.y[last[1]], p.y[last[2]], p.y[last[3]]),
+                    _mm_setr_ps(p.z[last[0]], p.z[last[1]], p.z[last[2]], p.z[last[3]]),
+                    _mm_setr_ps(p.w[last[0]], p.w[last[1]], p.w[last[2]], p.w[last[3]]),
+                    _mm_setr_ps(p.absX[last[0]], p.absX[last[1]], p.absX[last[2]], p.absX[last[3]]),
+                    _mm_setr_ps(p.absY[last[0]], p.absY[last[1]], p.absY[last[2]], p.absY[last[3]]),
+                    _mm_setr_ps(p.absZ[last[0]], p.absZ[last[1]], p.absZ[last[2]], p.absZ[last[3]]));
+
+            for (uint8_t plane = 0; plane < 6 && rejected != all; plane++) {
+                unsigned int outside = outsideSSE(b, sphere,
+                        _mm_set1_ps(p.x[plane]), _mm_set1_ps(p.y[plane]), _mm_set1_ps(p.z[plane]), _mm_set1_ps(p.w[plane]),
+                        _mm_set1_ps(p.absX[plane]), _mm_set1_ps(p.absY[plane]), _mm_set1_ps(p.absZ[plane]));
+
+                rejected = recordRejected(rejected, outside, plane, s.lastPlane + i);
+            }
+
+            writeVisibility(rejected, 4, s.visibility + i);
+            visible += 4 - countBits(rejected);
+        }
+
+        return visible + cullScalar(p, sphere, s, i, end);
+    }
+#endif
+
+#ifdef CULLER_AVX2
+    struct BatchAVX2 {
+        __m256 cx, cy, cz;
+        __m256 ex, ey, ez;
+    };
+
+    CULLER_TARGET("avx2,fma")
+    inline unsigned int outsideAVX2(const BatchAVX2 & b, const bool & sphere,
+                                    const __m256 & px, const __m256 & py, const __m256 & pz, const __m256 & pw,
+                                    const __m256 & ax, const __m256 & ay, const __m256 & az) {
+        __m256 dist = _mm256_fmadd_ps(px, b.cx, _mm256_fmadd_ps(py, b.cy, _mm256_fmadd_ps(pz, b.cz, pw)));
+
+        __m256 bound = sphere ? b.ex : _mm256_fmadd_ps(ax, b.ex, _mm256_fmadd_ps(ay, b.ey, _mm256_mul_ps(az, b.ez)));
+
+        __m256 test = _mm256_cmp_ps(_mm256_add_ps(dist, bound), _mm256_setzero_ps(), _CMP_LT_OQ);
+
+        return static_cast<unsigned int>(_mm256_movemask_ps(test));
+    }
+
+    CULLER_TARGET("avx2,fma")
+    size_t cullAVX2(const CullingPlanes & p, const bool & sphere, const CullingStreams & s, const size_t & begin, const size_t & end) {
+        const unsigned int all = 0xFF;
+
+        /// Six plane coefficients in low lanes, permuted per object by its last rejecting plane
+        const __m256i planeLanes = _mm256_setr_epi32(-1, -1, -1, -1, -1, -1, 0, 0);
+
+        const __m256 planeX = _mm256_maskload_ps(p.x, planeLanes);
+        const __m256 planeY = _mm256_maskload_ps(p.y, planeLanes);
+        const __m256 planeZ = _mm256_maskload_ps(p.z, planeLanes);
+        const __m256 planeW = _mm256_maskload_ps(p.w, planeLanes);
+        const __m256 planeAbsX = _mm256_maskload_ps(p.absX, planeLanes);
+        const __m256 planeAbsY = _mm256_maskload_ps(p.absY, planeLanes);
+        const __m256 planeAbsZ = _mm256_maskload_ps(p.absZ, planeLanes);
+
+        size_t visible = 0;
+        size_t i = begin;
+
+        for (; i + 8 <= end; i += 8) {
+            BatchAVX2 b;
+            b.cx = _mm256_loadu_ps(s.cx + i);
+            b.cy = _mm256_loadu_ps(s.cy + i);
+            b.cz = _mm256_loadu_ps(s.cz + i);
+
+            b.ex = _mm256_loadu_ps(sphere ? s.r + i : s.ex + i);
+            b.ey = _mm256_loadu_ps(s.ey + i);
+            b.ez = _mm256_loadu_ps(s.ez + i);
+
+            /// Each lane first tests plane that rejected it last time
+            __m256i last = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(s.lastPlane + i)));
+
+            unsigned int rejected = outsideAVX2(b, sphere,
+                    _mm256_permutevar8x32_ps(planeX, last), _mm256_permutevar8x32_ps(planeY, last),
+                    _mm256_permutevar8x32_ps(planeZ, last), _mm256_permutevar8x32_ps(planeW, last),
+                    _mm256_permutevar8x32_ps(planeAbsX, last), _mm256_permutevar8x32_ps(planeAbsY, last),
+                    _mm256_permutevar8x32_ps(planeAbsZ, last));
+
+            for (uint8_t plane = 0; plane < 6 && rejected != all; plane++) {
+                unsigned int outside = outsideAVX2(b, sphere,
+                        _mm256_set1_ps(p.x[plane]), _mm256_set1_ps(p.y[plane]), _mm256_set1_ps(p.z[plane]), _mm256_set1_ps(p.w[plane]),
+                        _mm256_set1_ps(p.absX[plane]), _mm256_set1_ps(p.absY[plane]), _mm256_set1_ps(p.absZ[plane]));
+
+                rejected = recordRejected(rejected, outside, plane, s.lastPlane + i);
+            }
+
+            writeVisibility(rejected, 8, s.visibility + i);
+            visible += 8 - countBits(rejected);
+        }
+
+        return visible + cullScalar(p, sphere, s, i, end);
+    }
+#endif
+
+#ifdef CULLER_AVX512
+    struct BatchAVX512 {
+        __m512 cx, cy, cz;
+        __m512 ex, ey, ez;
+    };
+
+    CULLER_TARGET("avx512f")
+    inline unsigned int outsideAVX512(const BatchAVX512 & b, const bool & sphere,
+                                      const __m512 & px, const __m512 & py, const __m512 & pz, const __m512 & pw,
+                                      const __m512 & ax, const __m512 & ay, const __m512 & az) {
+        __m512 dist = _mm512_fmadd_ps(px, b.cx, _mm512_fmadd_ps(py, b.cy, _mm512_fmadd_ps(pz, b.cz, pw)));
+
+        __m512 bound = sphere ? b.ex : _mm512_fmadd_ps(ax, b.ex, _mm512_fmadd_ps(ay, b.ey, _mm512_mul_ps(az, b.ez)));
+
+        return static_cast<unsigned int>(_mm512_cmp_ps_mask(_mm512_add_ps(dist, bound), _mm512_setzero_ps(), _CMP_LT_OQ));
+    }
+
+    CULLER_TARGET("avx512f")
+    size_t cullAVX512(const CullingPlanes & p, const bool & sphere, const CullingStreams & s, const size_t & begin, const size_t & end) {
+        const unsigned int all = 0xFFFF;
+
+        /// Six plane coefficients in low lanes, permuted per object by its last rejecting plane
+        const __mmask16 planeLanes = 0x3F;
+
+        const __m512 planeX = _mm512_maskz_loadu_ps(planeLanes, p.x);
+        const __m512 planeY = _mm512_maskz_loadu_ps(planeLanes, p.y);
+        const __m512 planeZ = _mm512_maskz_loadu_ps(planeLanes, p.z);
+        const __m512 planeW = _mm512_maskz_loadu_ps(planeLanes, p.w);
+        const __m512 planeAbsX = _mm512_maskz_loadu_ps(planeLanes, p.absX);
+        const __m512 planeAbsY = _mm512_maskz_loadu_ps(planeLanes, p.absY);
+        const __m512 planeAbsZ = _mm512_maskz_loadu_ps(planeLanes, p.absZ);
+
+        const __m512i one = _mm512_set1_epi32(1);
+
+        size_t visible = 0;
+        size_t i = begin;
+
+        for (; i + 16 <= end; i += 16) {
+            BatchAVX512 b;
+            b.cx = _mm512_loadu_ps(s.cx + i);
+            b.cy = _mm512_loadu_ps(s.cy + i);
+            b.cz = _mm512_loadu_ps(s.cz + i);
+
+            b.ex = _mm512_loadu_ps(sphere ? s.r + i : s.ex + i);
+            b.ey = _mm512_loadu_ps(s.ey + i);
+            b.ez = _mm512_loadu_ps(s.ez + i);
+
+            /// Each lane first tests plane that rejected it last time
+            __m512i last = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s.lastPlane + i)));
+
+            unsigned int rejected = outsideAVX512(b, sphere,
+                    _mm512_permutexvar_ps(last, planeX), _mm512_permutexvar_ps(last, planeY),
+                    _mm512_permutexvar_ps(last, planeZ), _mm512_permutexvar_ps(last, planeW),
+                    _mm512_permutexvar_ps(last, planeAbsX), _mm512_permutexvar_ps(last, planeAbsY),
+                    _mm512_permutexvar_ps(last, planeAbsZ));
+
+            for (uint8_t plane = 0; plane < 6 && rejected != all; plane++) {
+                unsigned int outside = outsideAVX512(b, sphere,
+                        _mm512_set1_ps(p.x[plane]), _mm512_set1_ps(p.y[plane]), _mm512_set1_ps(p.z[plane]), _mm512_set1_ps(p.w[plane]),
+                        _mm512_set1_ps(p.absX[plane]), _mm512_set1_ps(p.absY[plane]), _mm512_set1_ps(p.absZ[plane]));
+
+                rejected = recordRejected(rejected, outside, plane, s.lastPlane + i);
+            }
+
+            /// Narrow 16 visibility flags to bytes in one store
+            __m512i flags = _mm512_maskz_mov_epi32(static_cast<__mmask16>(~rejected), one);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(s.visibility + i), _mm512_cvtepi32_epi8(flags));
+
+            visible += 16 - countBits(rejected);
+        }
+
+        return visible + cullScalar(p, sphere, s, i, end);
+    }
+#endif
+}
+
+void FrustumCuller::resize(const size_t & newCount) {
+    count = newCount;
+
+    centerX.resize(count, 0.0f);
+    centerY.resize(count, 0.0f);
+    centerZ.resize(count, 0.0f);
+
+    extentX.resize(count, 0.0f);
+    extentY.resize(count, 0.0f);
+    extentZ.resize(count, 0.0f);
+
+    radius.resize(count, 0.0f);
+
+    lastPlane.resize(count, 0);
+}
+
+void FrustumCuller::setSphere(const size_t & index, const float & x, const float & y, const float & z, const float & r) {
+    centerX[index] = x;
+    centerY[index] = y;
+    centerZ[index] = z;
+
+    extentX[index] = r;
+    extentY[index] = r;
+    extentZ[index] = r;
+
+    radius[index] = r;
+}
+
+void FrustumCuller::setAabb(const size_t & index, const float & x, const float & y, const float & z, const float & ex, const float & ey, const float & ez) {
+    centerX[index] = x;
+    centerY[index] = y;
+    centerZ[index] = z;
+
+    extentX[index] = ex;
+    extentY[index] = ey;
+    extentZ[index] = ez;
+
+    radius[index] = std::sqrt(ex * ex + ey * ey + ez * ez);
+}
+
+CullingPlanes FrustumCuller::preparePlanes(const glm::vec4 * planes) {
+    CullingPlanes p{};
+
+    for (int i = 0; i < 6; i++) {
+        p.x[i] = planes[i].x;
+        p.y[i] = planes[i].y;
+        p.z[i] = planes[i].z;
+        p.w[i] = planes[i].w;
+
+        p.absX[i] = std::abs(planes[i].x);
+        p.absY[i] = std::abs(planes[i].y);
+        p.absZ[i] = std::abs(planes[i].z);
+    }
+
+    return p;
+}
+
+bool FrustumCuller::isSupported(const CullingPath & path) {
+    switch (path) {
+        case CullingPath::Scalar:
+            return true;
+#ifdef CULLER_SSE
+        case CullingPath::SSE:
+            return true;
+#endif
+#ifdef CULLER_AVX2
+        case CullingPath::AVX2:
+    #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    #else
+            return true;
+    #endif
+#endif
+#ifdef CULLER_AVX512
+        case CullingPath::AVX512:
+    #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports("avx512f");
+    #else
+            return true;
+    #endif
+#endif
+        default:
+            return false;
+    }
+}
+
+CullingPath FrustumCuller::bestPath() {
+    static const CullingPath path = [] {
+        for (auto candidate : { CullingPath::AVX512, CullingPath::AVX2, CullingPath::SSE }) {
+            if (isSupported(candidate)) {
+                return candidate;
+            }
+        }
+
+        return CullingPath::Scalar;
+    }();
+
+    return path;
+}
+
+const char * FrustumCuller::pathName(const CullingPath & path) {
+    switch (path) {
+        case CullingPath::SSE:
+            return "SSE";
+        case CullingPath::AVX2:
+            return "AVX2";
+        case CullingPath::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+    }
+}
+
+size_t FrustumCuller::cullRange(const CullingPlanes & planes, const CullingVolume & volume, const CullingPath & path,
+                                const size_t & begin, const size_t & end, unsigned char * visibility) {
+    CullingStreams streams {
+        centerX.data(), centerY.data(), centerZ.data(),
+        extentX.data(), extentY.data(), extentZ.data(),
+        radius.data(),
+        lastPlane.data(),
+        visibility
+    };
+
+    bool sphere = volume == CullingVolume::Sphere;
+
+    switch (path) {
+#ifdef CULLER_AVX512
+        case CullingPath::AVX512:
+            return cullAVX512(planes, sphere, streams, begin, end);
+#endif
+#ifdef CULLER_AVX2
+        case CullingPath::AVX2:
+            return cullAVX2(planes, sphere, streams, begin, end);
+#endif
+#ifdef CULLER_SSE
+        case CullingPath::SSE:
+            return cullSSE(planes, sphere, streams, begin, end);
+#endif
+        default:
+            return cullScalar(planes, sphere, streams, begin, end);
+    }
+}
+
+void FrustumCuller::cull(const glm::vec4 * planes, const CullingVolume & volume, unsigned char * visibility) {
+    PROFILE_FUNCTION();
+
+    CullingPlanes p = preparePlanes(planes);
+    CullingPath path = bestPath();
+
+    std::atomic<size_t> visible(0);
+
+    /// Grain is a multiple of widest batch, so only last range falls back to scalar tail
+    JobSystem::Instance().parallelFor(0, count, GRAIN_SIZE, [&](size_t begin, size_t end) {
+        visible += cullRange(p, volume, path, begin, end, visibility);
+    });
+
+    visibleCount = visible;
+}
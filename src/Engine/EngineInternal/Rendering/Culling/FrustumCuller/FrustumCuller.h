@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm/vec4.hpp>
+
+enum class CullingVolume {
+    Sphere,
+    Aabb
+};
+
+enum class CullingPath {
+    Scalar,
+    SSE,
+    AVX2,
+    AVX512
+};
+
+/// Frustum planes in structure-of-arrays form, with absolute normals for box tests
+struct CullingPlanes {
+    float x[6];
+    float y[6];
+    float z[6];
+    float w[6];
+
+    float absX[6];
+    float absY[6];
+    float absZ[6];
+};
+
+/// Culls world space bounds stored as structure-of-arrays against six frustum planes.
+///
+/// Objects are processed 4/8/16 at a time (SSE2/AVX2/AVX-512) depending on widest instruction set
+/// available at runtime, and the array is split across job system workers. Plane that rejected an object
+/// last time is tested first, so a batch of objects that stay outside is usually rejected by a single test.
+class FrustumCuller {
+
+    private:
+
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+
+        std::vector<float> extentX;
+        std::vector<float> extentY;
+        std::vector<float> extentZ;
+
+        std::vector<float> radius;
+
+        /// Temporal coherence - index of plane that rejected object in previous test
+        std::vector<uint8_t> lastPlane;
+
+        size_t count = 0;
+
+        size_t visibleCount = 0;
+
+    public:
+
+        /// Objects processed per job, multiple of widest batch
+        static constexpr size_t GRAIN_SIZE = 16 * 1024;
+
+        void resize(const size_t & count);
+
+        size_t size() const { return count; }
+
+        size_t getVisibleCount() const { return visibleCount; }
+
+        /// Sets sphere bounds; box tests treat it as cube enclosing the sphere
+        void setSphere(const size_t & index, const float & x, const float & y, const float & z, const float & r);
+
+        /// Sets box bounds from center and half extents; sphere tests use enclosing sphere
+        void setAabb(const size_t & index, const float & x, const float & y, const float & z, const float & ex, const float & ey, const float & ez);
+
+        /// Tests all objects, writes 1 for visible and 0 for culled object into visibility (size() entries)
+        void cull(const glm::vec4 * planes, const CullingVolume & volume, unsigned char * visibility);
+
+        /// Tests object range on calling thread using given path, path must be supported by CPU.
+        /// Returns number of visible objects in range.
+        size_t cullRange(const CullingPlanes & planes, const CullingVolume & volume, const CullingPath & path,
+                         const size_t & begin, const size_t & end, unsigned char * visibility);
+
+        static CullingPlanes preparePlanes(const glm::vec4 * planes);
+
+        /// Widest path supported by both compiler and CPU
+        static CullingPath bestPath();
+
+        static bool isSupported(const CullingPath & path);
+
+        static const char * pathName(const CullingPath & path);
+};
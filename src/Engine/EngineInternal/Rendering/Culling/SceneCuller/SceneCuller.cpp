@@ -0,0 +1,322 @@
+#include "SceneCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Engine/EngineInternal/Time.h>
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
+
+BvhAabb SceneCuller::calculateBounds(const GameObjectBase & object, const float & alpha) {
+    const Transform & t = object.transform();
+
+    /// Transform relative to parent - box is transformed by full world matrix
+    if (t.hasParent()) {
+        glm::mat4x4 world = t.calculateWorldMatrix(alpha);
+
+        glm::vec3 localCenter = object.boundingBox.get() ? object.bbox.center : glm::vec3(0.0f);
+        glm::vec3 localHalfSize = object.boundingBox.get() ? object.bbox.size * 0.5f : glm::vec3(1.0f);
+
+        glm::vec3 center = glm::vec3(world * glm::vec4(localCenter, 1.0f));
+        glm::vec3 extent;
+
+        for (int axis = 0; axis < 3; axis++) {
+            extent[axis] = std::abs(world[0][axis]) * localHalfSize.x
+                         + std::abs(world[1][axis]) * localHalfSize.y
+                         + std::abs(world[2][axis]) * localHalfSize.z;
+        }
+
+        BvhAabb box;
+        box.min = center - extent;
+        box.max = center + extent;
+        return box;
+    }
+
+    glm::vec3 position = t.interpolatedPosition(alpha);
+    glm::vec3 scale = t.interpolatedScale(alpha);
+
+    glm::vec3 center = position;
+    glm::vec3 extent;
+
+    if (!object.boundingBox.get()) {
+        extent = glm::vec3(std::max(std::max(scale.x, scale.y), scale.z));
+    }
+    else {
+        glm::vec3 offset = scale * object.bbox.center;
+        glm::vec3 halfSize = glm::abs(scale * object.bbox.size) * 0.5f;
+
+        if (!t.isRotated()) {
+            center += offset;
+            extent = halfSize;
+        }
+        else {
+            /// Rotated mesh is bounded by its bounding sphere, scaled by largest scale and placed around pivot
+            glm::vec3 absScale = glm::abs(scale);
+            float radius = object.bbox.radius * std::max(std::max(absScale.x, absScale.y), absScale.z);
+
+            extent = glm::vec3(glm::length(offset) + std::min(radius, glm::length(halfSize)));
+        }
+    }
+
+    BvhAabb box;
+    box.min = center - extent;
+    box.max = center + extent;
+    return box;
+}
+
+void SceneCuller::build(const std::vector<std::shared_ptr<RenderInfo>> & renderInfos) {
+    PROFILE_FUNCTION();
+
+    infos.clear();
+    infoIndexes.clear();
+    infoRenderables.clear();
+    freeInfos.clear();
+
+    renderables.clear();
+    freeRenderables.clear();
+    renderableIndexes.clear();
+    dynamicRenderables.clear();
+    alwaysVisibleRenderables.clear();
+    staticTree.clear();
+    dynamicTree.clear();
+
+    for (auto & info : renderInfos) {
+        for (auto & object : info->objects) {
+            add(info, object.get());
+        }
+    }
+}
+
+void SceneCuller::add(const std::shared_ptr<RenderInfo> & info, GameObjectBase * object) {
+    if (renderableIndexes.count(object) > 0) return;
+
+    auto found = infoIndexes.find(info.get());
+
+    if (found == infoIndexes.end()) {
+        uint32_t infoIndex;
+
+        if (!freeInfos.empty()) {
+            infoIndex = freeInfos.back();
+            freeInfos.pop_back();
+            infos[infoIndex] = info;
+        }
+        else {
+            infoIndex = static_cast<uint32_t>(infos.size());
+            infos.push_back(info);
+            infoRenderables.push_back(0);
+        }
+
+        found = infoIndexes.emplace(info.get(), infoIndex).first;
+    }
+
+    infoRenderables[found->second]++;
+
+    uint32_t index;
+
+    if (!freeRenderables.empty()) {
+        index = freeRenderables.back();
+        freeRenderables.pop_back();
+    }
+    else {
+        index = static_cast<uint32_t>(renderables.size());
+        renderables.emplace_back();
+    }
+
+    Renderable & renderable = renderables[index];
+    renderable.object = object;
+    renderable.infoIndex = found->second;
+    renderable.proxy = -1;
+    /// Child follows its parent, which may be moved by behaviours
+    renderable.dynamic = object->hasBehaviours() || object->transform().hasParent();
+    renderable.alwaysVisible = !info->renderer->frustumCulling;
+
+    float alpha = Time::Instance().interpolationAlpha;
+
+    /// Never culled objects (skybox, grid) are not useful for spatial queries either
+    if (renderable.alwaysVisible) {
+        renderable.listIndex = static_cast<uint32_t>(alwaysVisibleRenderables.size());
+        alwaysVisibleRenderables.push_back(index);
+    }
+    else if (renderable.dynamic) {
+        renderable.proxy = dynamicTree.insert(calculateBounds(*object, alpha), index);
+        renderable.listIndex = static_cast<uint32_t>(dynamicRenderables.size());
+        dynamicRenderables.push_back(index);
+    }
+    else {
+        renderable.proxy = staticTree.insert(calculateBounds(*object, alpha), index);
+    }
+
+    renderableIndexes[object] = index;
+}
+
+void SceneCuller::remove(const GameObjectBase * object) {
+    auto found = renderableIndexes.find(object);
+    if (found == renderableIndexes.end()) return;
+
+    uint32_t index = found->second;
+    renderableIndexes.erase(found);
+
+    Renderable & renderable = renderables[index];
+
+    /// Lists are unordered - last entry takes place of removed one
+    auto removeFromList = [this, &renderable](std::vector<uint32_t> & list) {
+        uint32_t last = list.back();
+        list[renderable.listIndex] = last;
+        renderables[last].listIndex = renderable.listIndex;
+        list.pop_back();
+    };
+
+    if (renderable.alwaysVisible) {
+        removeFromList(alwaysVisibleRenderables);
+    }
+    else if (renderable.dynamic) {
+        dynamicTree.remove(renderable.proxy);
+        removeFromList(dynamicRenderables);
+    }
+    else {
+        staticTree.remove(renderable.proxy);
+    }
+
+    /// Slot of released info is reused by next new info, indexes of other infos do not change
+    if (--infoRenderables[renderable.infoIndex] == 0) {
+        infoIndexes.erase(infos[renderable.infoIndex].get());
+        infos[renderable.infoIndex] = nullptr;
+        freeInfos.push_back(renderable.infoIndex);
+    }
+
+    renderable = Renderable();
+    freeRenderables.push_back(index);
+}
+
+void SceneCuller::refresh(GameObjectBase * object) {
+    auto found = renderableIndexes.find(object);
+    if (found == renderableIndexes.end()) return;
+
+    /// Info is kept alive in case object is its only user
+    std::shared_ptr<RenderInfo> info = infos[renderables[found->second].infoIndex];
+
+    remove(object);
+    add(info, object);
+}
+
+void SceneCuller::cull(const FrustumPlanes & frustum, const float & alpha) {
+    PROFILE_FUNCTION();
+
+    auto & jobs = JobSystem::Instance();
+
+    size_t dynamicCount = dynamicRenderables.size();
+
+    if (dynamicBounds.size() != dynamicCount) {
+        dynamicBounds.resize(dynamicCount);
+        dynamicVisibility.resize(dynamicCount);
+        dynamicCuller.resize(dynamicCount);
+    }
+
+    /// Dynamic bounds - computed in parallel, tree is updated serially
+    {
+        PROFILE_SCOPE("UpdateDynamicBounds");
+
+        jobs.parallelFor(0, dynamicCount, jobs.defaultGrainSize(dynamicCount, 1024), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const BvhAabb & box = dynamicBounds[i] = calculateBounds(*renderables[dynamicRenderables[i]].object, alpha);
+
+                glm::vec3 center = box.center();
+                glm::vec3 extent = box.extent();
+
+                dynamicCuller.setAabb(i, center.x, center.y, center.z, extent.x, extent.y, extent.z);
+            }
+        });
+
+        for (size_t i = 0; i < dynamicCount; i++) {
+            dynamicTree.move(renderables[dynamicRenderables[i]].proxy, dynamicBounds[i]);
+        }
+    }
+
+    visibleRenderables.clear();
+
+    {
+        PROFILE_SCOPE("CullStatic");
+        staticTree.queryFrustum(frustum.data(), visibleRenderables);
+    }
+
+    {
+        PROFILE_SCOPE("CullDynamic");
+
+        dynamicCuller.cull(frustum.data(), CullingVolume::Aabb, dynamicVisibility.data());
+
+        for (size_t i = 0; i < dynamicCount; i++) {
+            if (dynamicVisibility[i]) {
+                visibleRenderables.push_back(dynamicRenderables[i]);
+            }
+        }
+    }
+
+    visibleRenderables.insert(visibleRenderables.end(), alwaysVisibleRenderables.begin(), alwaysVisibleRenderables.end());
+}
+
+void SceneCuller::queryAabb(const BvhAabb & box, std::vector<GameObjectBase *> & out) const {
+    std::vector<uint32_t> found;
+
+    staticTree.queryAabb(box, found);
+    dynamicTree.queryAabb(box, found);
+
+    for (auto & index : found) {
+        out.push_back(renderables[index].object);
+    }
+}
+
+bool SceneCuller::raycast(const glm::vec3 & origin, const glm::vec3 & direction, const float & maxDistance, SceneRayHit & hit) const {
+    float alpha = Time::Instance().interpolationAlpha;
+    glm::vec3 inverseDirection = glm::vec3(1.0f) / direction;
+
+    /// Trees store enlarged boxes, test tight bounds of candidate objects
+    auto hitTest = [&](uint32_t index, float) {
+        BvhAabb box = calculateBounds(*renderables[index].object, alpha);
+
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int axis = 0; axis < 3; axis++) {
+            float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+            float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+
+        return tMin <= tMax ? tMin : -1.0f;
+    };
+
+    BvhRayHit staticHit;
+    BvhRayHit dynamicHit;
+
+    bool hitStatic = staticTree.raycast(origin, direction, maxDistance, staticHit, hitTest);
+    bool hitDynamic = dynamicTree.raycast(origin, direction, hitStatic ? staticHit.distance : maxDistance, dynamicHit, hitTest);
+
+    if (!hitStatic && !hitDynamic) return false;
+
+    const BvhRayHit & closest = hitDynamic ? dynamicHit : staticHit;
+
+    hit.object = renderables[closest.userData].object;
+    hit.distance = closest.distance;
+
+    return true;
+}
+
+void SceneCuller::nearest(const glm::vec3 & point, const size_t & k, std::vector<SceneNearest> & out) const {
+    std::vector<BvhNearest> found;
+
+    staticTree.nearest(point, k, found);
+    dynamicTree.nearest(point, k, found);
+
+    std::sort(found.begin(), found.end(), [](const BvhNearest & a, const BvhNearest & b) {
+        return a.distance < b.distance;
+    });
+
+    for (size_t i = 0; i < found.size() && i < k; i++) {
+        SceneNearest entry;
+        entry.object = renderables[found[i].userData].object;
+        entry.distance = found[i].distance;
+        out.push_back(entry);
+    }
+}
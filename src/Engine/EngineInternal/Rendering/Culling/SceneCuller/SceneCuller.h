@@ -0,0 +1,124 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <Rendering/Culling/Bvh/Bvh.h>
+#include <Rendering/Culling/FrustumCuller/FrustumCuller.h>
+#include <Rendering/Camera/PerspectiveCamera/PerspectiveCamera.h>
+#include <Rendering/Mesh/RenderInfo.h>
+
+/// Object rendered by one of render infos. Index of renderable is stable while object is registered,
+/// its instance index is kept by transform matrix target, which render info updates when instances move.
+struct Renderable {
+    /// Null for free slots
+    GameObjectBase * object = nullptr;
+
+    uint32_t infoIndex = 0;
+
+    /// Proxy in static or dynamic tree, -1 for objects which are never culled
+    int proxy = -1;
+
+    /// Position in dynamic or never culled list
+    uint32_t listIndex = 0;
+
+    /// Moved by behaviours, bounds are refreshed every frame
+    bool dynamic = false;
+
+    bool alwaysVisible = false;
+};
+
+struct SceneRayHit {
+    GameObjectBase * object = nullptr;
+    float distance = 0.0f;
+};
+
+struct SceneNearest {
+    GameObjectBase * object = nullptr;
+    float distance = 0.0f;
+};
+
+/// Scene level visibility and spatial queries.
+///
+/// Objects without behaviours and parents never move, so they live in a static BVH which is built once
+/// and culled hierarchically - its cost depends on visible set, not scene size.
+/// Dynamic objects are kept in a second BVH, updated when they leave their enlarged boxes,
+/// and culled with SIMD frustum culler because their bounds have to be rewritten every frame anyway.
+///
+/// Queries read both trees and must not run while frame is being prepared on pipeline thread.
+class SceneCuller {
+
+    private:
+
+        std::vector<std::shared_ptr<RenderInfo>> infos;
+
+        std::vector<Renderable> renderables;
+
+        std::vector<uint32_t> freeRenderables;
+
+        std::unordered_map<const GameObjectBase *, uint32_t> renderableIndexes;
+
+        std::unordered_map<const RenderInfo *, uint32_t> infoIndexes;
+
+        /// Renderables of every info, info is dropped when its last renderable is removed
+        std::vector<uint32_t> infoRenderables;
+
+        std::vector<uint32_t> freeInfos;
+
+        /// Culled dynamic renderables, indexed the same way as dynamic culler entries
+        std::vector<uint32_t> dynamicRenderables;
+
+        std::vector<uint32_t> alwaysVisibleRenderables;
+
+        std::vector<BvhAabb> dynamicBounds;
+        std::vector<unsigned char> dynamicVisibility;
+
+        FrustumCuller dynamicCuller;
+
+        Bvh staticTree;
+        Bvh dynamicTree;
+
+        /// Result of last cull
+        std::vector<uint32_t> visibleRenderables;
+
+    public:
+
+        /// World space box of object at interpolated state
+        static BvhAabb calculateBounds(const GameObjectBase & object, const float & alpha);
+
+        /// Registers all objects of given render infos, indexes of infos are used by Renderable::infoIndex
+        void build(const std::vector<std::shared_ptr<RenderInfo>> & renderInfos);
+
+        /// Registers object rendered by info, info is added when it is not known yet
+        void add(const std::shared_ptr<RenderInfo> & info, GameObjectBase * object);
+
+        /// Unregisters object, its info is released once no other object uses it
+        void remove(const GameObjectBase * object);
+
+        /// Registers object again with its current bounds and renderer settings, e.g. after static object was moved
+        void refresh(GameObjectBase * object);
+
+        bool contains(const GameObjectBase * object) const { return renderableIndexes.count(object) > 0; }
+
+        void cull(const FrustumPlanes & frustum, const float & alpha);
+
+        /// Infos indexed by Renderable::infoIndex, free slots are null
+        const std::vector<std::shared_ptr<RenderInfo>> & getInfos() const { return infos; }
+
+        const Renderable & getRenderable(const uint32_t & index) const { return renderables[index]; }
+
+        size_t getRenderableCount() const { return renderableIndexes.size(); }
+
+        const std::vector<uint32_t> & getVisible() const { return visibleRenderables; }
+
+        size_t getStaticCount() const { return staticTree.size(); }
+
+        size_t getDynamicCount() const { return dynamicTree.size(); }
+
+        void queryAabb(const BvhAabb & box, std::vector<GameObjectBase *> & out) const;
+
+        bool raycast(const glm::vec3 & origin, const glm::vec3 & direction, const float & maxDistance, SceneRayHit & hit) const;
+
+        void nearest(const glm::vec3 & point, const size_t & k, std::vector<SceneNearest> & out) const;
+};
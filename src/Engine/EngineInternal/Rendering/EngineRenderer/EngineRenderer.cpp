@@ -1,8 +1,15 @@
 #include <Rendering/Mesh/MeshBuilder.h>
 #include "EngineRenderer.h"
+#include <algorithm>
 #include <ctime>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <Engine/EngineInternal/Settings.h>
+#include <Profiling/GpuProfiler/GpuProfiler.h>
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+#include <Profiling/Profile.h>
+#include <Engine/EngineInternal/Time.h>
 
 EngineRenderer::EngineRenderer(const std::shared_ptr<Window> & window,
                                const std::shared_ptr<PhysicsEngine> & physicsEngine) {
@@ -19,88 +26,364 @@ EngineRenderer::EngineRenderer(const std::shared_ptr<Window> & window,
 
 void EngineRenderer::addScene(const std::shared_ptr<Scene> & scene) {
     for (auto & child : scene->children) {
-        renderingManager->children.push_back(child);
+        addObject(child);
     }
 }
 
-void EngineRenderer::prepare() {
-    renderingManager->preprocessScenes();
+void EngineRenderer::addObject(const std::shared_ptr<GameObject> & object) {
+    if (prepared) {
+        CommandBuffer commands;
+        commands.spawn(object);
+        commands.submit();
+        return;
+    }
 
-    for (auto & info : renderingManager->renderInfos) {
-        info->renderer->prepare();
+    renderingManager->addChild(object);
+
+    for (auto & child : object->children) {
+        addObject(child);
     }
+}
 
-    for (auto & [id, info] : renderingManager->instancedRenderInfos) {
+void EngineRenderer::applyCommands() {
+    auto & queue = CommandQueue::Instance();
+
+    if (queue.empty()) return;
+
+    PROFILE_FUNCTION();
+
+    auto batches = queue.drain();
+
+    /// Last spawn or destroy request of every object, objects in order of their first request
+    std::vector<std::shared_ptr<GameObject>> requested;
+    std::unordered_map<const GameObject *, bool> spawnRequested;
+
+    /// Objects moved or changed by commands, registered in culler again once all commands are applied
+    std::vector<GameObject *> changed;
+    std::unordered_set<const GameObject *> changedSet;
+
+    for (auto & commands : batches) {
+        for (auto & command : commands) {
+            /// Objects of other threads are created here, on main thread
+            if (command.create) {
+                command.object = command.create();
+                if (!command.object.get()) continue;
+            }
+
+            if (command.type == CommandBuffer::Command::Type::SET_TRANSFORM ||
+                command.type == CommandBuffer::Command::Type::SET_FIELD) {
+                if (changedSet.insert(command.object.get()).second) {
+                    changed.push_back(command.object.get());
+                }
+            }
+
+            switch (command.type) {
+                case CommandBuffer::Command::Type::SPAWN:
+                case CommandBuffer::Command::Type::DESTROY: {
+                    bool spawn = command.type == CommandBuffer::Command::Type::SPAWN;
+                    auto [found, inserted] = spawnRequested.try_emplace(command.object.get(), spawn);
+
+                    if (inserted) {
+                        requested.push_back(command.object);
+                    }
+                    else {
+                        found->second = spawn;
+                    }
+                    break;
+                }
+                case CommandBuffer::Command::Type::SET_TRANSFORM: {
+                    auto & transform = command.object->transform();
+                    transform.setPosition(command.position);
+                    transform.setOrientation(command.orientation);
+                    transform.setScale(command.scale);
+                    break;
+                }
+                case CommandBuffer::Command::Type::SET_FIELD: {
+                    command.apply(*command.object);
+                    break;
+                }
+            }
+        }
+    }
+
+    /// Removals first - spawned objects reuse freed instance and culler slots
+    for (auto & object : requested) {
+        if (!spawnRequested[object.get()] && renderingManager->contains(object.get())) {
+            despawnNow(object);
+        }
+    }
+
+    std::vector<std::shared_ptr<RenderInfo>> createdInfos;
+
+    for (auto & object : requested) {
+        if (spawnRequested[object.get()]) {
+            spawnNow(object, createdInfos);
+        }
+    }
+
+    /// Static tree keeps bounds from registration, changed field may also change how object is culled
+    for (auto * object : changed) {
+        sceneCuller.refresh(object);
+    }
+
+    prepareRenderInfos(createdInfos);
+}
+
+void EngineRenderer::spawnNow(const std::shared_ptr<GameObject> & object,
+                              std::vector<std::shared_ptr<RenderInfo>> & createdInfos) {
+    if (renderingManager->contains(object.get())) return;
+
+    auto info = renderingManager->addObject(object, createdInfos);
+
+    /// Bounding boxes are culled together with their parents
+    if (info.get()) {
+        sceneCuller.add(info, object.get());
+    }
+
+    for (auto & child : object->children) {
+        spawnNow(child, createdInfos);
+    }
+}
+
+void EngineRenderer::despawnNow(const std::shared_ptr<GameObject> & object) {
+    for (auto & child : object->children) {
+        despawnNow(child);
+    }
+
+    sceneCuller.remove(object.get());
+    renderingManager->removeObject(object);
+}
+
+void EngineRenderer::prepareRenderInfos(const std::vector<std::shared_ptr<RenderInfo>> & infos) {
+    /// Normals are CPU only - generate them for all meshes in parallel before GL buffers are created
+    JobSystem::Instance().parallelFor(0, infos.size(), 1, [&infos](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            infos[i]->renderer->generateNormals();
+        }
+    });
+
+    for (auto & info : infos) {
         info->renderer->prepare();
     }
 }
 
-void EngineRenderer::testFrustrum(const std::shared_ptr<RenderInfo> & info) {
+void EngineRenderer::uploadLoadedMeshes() {
+    std::vector<std::shared_ptr<RenderInfo>> loadedInfos;
 
-    info->renderer->usedMeshIndexes.clear();
+    renderingManager->takeLoadedMeshes(loadedInfos, MESH_UPLOADS_PER_FRAME);
 
-    for (int i = 0; i < info->objects.size(); i++) {
-        if (info->renderer->frustumCulling) {
-            if (perspectiveCameras[0]->testFrustum(info->objects[i])) {
-                info->renderer->usedMeshIndexes.push_back(i);
-            }
+    if (loadedInfos.empty()) return;
+
+    PROFILE_FUNCTION();
+
+    /// Placeholder buffers are replaced, instance data stays in the same mesh
+    for (auto & info : loadedInfos) {
+        info->renderer->release();
+    }
+
+    prepareRenderInfos(loadedInfos);
+
+    /// Bounds of objects changed with geometry, static tree entries are rebuilt
+    for (auto & info : loadedInfos) {
+        for (auto & object : info->objects) {
+            if (!sceneCuller.contains(object.get())) continue;
+
+            sceneCuller.remove(object.get());
+            sceneCuller.add(info, object.get());
         }
-        else {
-            info->renderer->usedMeshIndexes.push_back(i);
+    }
+}
+
+void EngineRenderer::releaseEmptyInfos() {
+    renderingManager->releaseEmptyInfos();
+}
+
+void EngineRenderer::prepare() {
+    PROFILE_FUNCTION();
+
+    renderingManager->preprocessScenes();
+
+    std::vector<std::shared_ptr<RenderInfo>> infos(renderingManager->renderInfos);
+
+    for (auto & [id, info] : renderingManager->instancedRenderInfos) {
+        infos.push_back(info);
+    }
+
+    prepareRenderInfos(infos);
+
+    /// Bounding boxes are culled together with their parents
+    std::vector<std::shared_ptr<RenderInfo>> culledInfos;
+
+    for (auto & [id, info] : renderingManager->instancedRenderInfos) {
+        if (id != "bbox") {
+            culledInfos.push_back(info);
         }
     }
+
+    for (auto & info : renderingManager->renderInfos) {
+        culledInfos.push_back(info);
+    }
+
+    sceneCuller.build(culledInfos);
+
+    prepared = true;
 }
 
-void EngineRenderer::renderFrame() {
+void EngineRenderer::tick() {
+    renderingManager->tick();
+}
 
-    /// Update all cameras
+void EngineRenderer::updateCameras() {
     perspectiveCameras[0]->Update();
     perspectiveCameras[1]->Update();
     ortographicCamera->Update();
+}
 
-    /// Update all instanced rendered children
-    for (auto const & [id, info] : renderingManager->instancedRenderInfos) {
-        testFrustrum(info);
+void EngineRenderer::prepareFrame(const FrustumPlanes & frustum) {
+    PROFILE_FUNCTION();
+
+    float alpha = Time::Instance().interpolationAlpha;
+    auto & transforms = TransformStorage::Instance();
+
+    transforms.clearVisible();
+
+    sceneCuller.cull(frustum, alpha);
+
+    auto & visible = sceneCuller.getVisible();
+
+    /// Visible objects mark their transforms and bounding boxes visible, every object touches only its own slots.
+    /// Objects outside of frustum are not touched at all, their matrices are computed once they become visible.
+    {
+        PROFILE_SCOPE("UpdateObjects");
+
+        auto & jobs = JobSystem::Instance();
+
+        jobs.parallelFor(0, visible.size(), jobs.defaultGrainSize(visible.size(), 1024), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                sceneCuller.getRenderable(visible[i]).object->update(true);
+            }
+        });
+    }
+
+    /// Interpolated matrices of visible transforms are written straight into instance arrays
+    transforms.computeMatrices(alpha);
+
+    {
+        PROFILE_SCOPE("CollectVisible");
+
+        auto & infos = sceneCuller.getInfos();
+
+        for (auto & info : infos) {
+            if (info) {
+                info->renderer->backFrame().usedMeshIndexes.clear();
+            }
+        }
+
+        std::vector<int> * boundingBoxIndexes = nullptr;
+
+        auto boundingBoxInfo = renderingManager->instancedRenderInfos.find("bbox");
+
+        if (boundingBoxInfo != renderingManager->instancedRenderInfos.end()) {
+            boundingBoxIndexes = &boundingBoxInfo->second->renderer->backFrame().usedMeshIndexes;
+            boundingBoxIndexes->clear();
+        }
+
+        /// Bounding box is visible together with its parent
+        for (auto & index : visible) {
+            auto & renderable = sceneCuller.getRenderable(index);
+
+            infos[renderable.infoIndex]->renderer->backFrame().usedMeshIndexes.push_back(renderable.object->transform().getMatrixIndex());
+
+            if (boundingBoxIndexes && renderable.object->boundingBox.get()) {
+                boundingBoxIndexes->push_back(renderable.object->boundingBox->transform().getMatrixIndex());
+            }
+        }
+
+        /// Keep instance order stable between frames
+        for (auto & info : infos) {
+            if (!info) continue;
 
-        if (id == "bbox") continue;
+            auto & indexes = info->renderer->backFrame().usedMeshIndexes;
+            std::sort(indexes.begin(), indexes.end());
+        }
 
-        for (auto & child : info->objects) {
-            child->update(!child->culled);
+        if (boundingBoxIndexes) {
+            std::sort(boundingBoxIndexes->begin(), boundingBoxIndexes->end());
         }
     }
 
-    /// Update all classic rendered children
-    for (auto const & info : renderingManager->renderInfos) {
-        testFrustrum(info);
+    /// Bounding boxes are updated by their parents, so gather after all updates
+    {
+        PROFILE_SCOPE("GatherInstances");
 
-        for (auto & child : info->objects) {
-            child->update(!child->culled);
+        for (auto const & [id, info] : renderingManager->instancedRenderInfos) {
+            info->renderer->gatherFrame();
+        }
+
+        for (auto const & info : renderingManager->renderInfos) {
+            info->renderer->gatherFrame();
         }
     }
 
+    backFrameReady = true;
+}
+
+void EngineRenderer::swapFrames() {
+    if (!backFrameReady) return;
+
+    for (auto const & [id, info] : renderingManager->instancedRenderInfos) {
+        info->renderer->swapFrames();
+    }
+
+    for (auto const & info : renderingManager->renderInfos) {
+        info->renderer->swapFrames();
+    }
+
+    backFrameReady = false;
+}
+
+void EngineRenderer::renderFrame() {
+    PROFILE_FUNCTION();
+
+    auto & gpuProfiler = GpuProfiler::Instance();
+
     /// Clear all framebuffers
+    gpuProfiler.beginZone("Clear");
+
     for (unsigned int framebuffer : framebuffers) {
         glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
         glClearColor(0.17f, 0.17f, 0.17f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
+    gpuProfiler.endZone();
+
     /// Render all children
     for (int i = 0; i < 2; i++) {
+        GpuProfilerScope viewportScope(viewportZoneNames[i]);
+
         glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[i]);
         glViewport(0, 0, widths[i], heights[i]);
 
         /// Render all instanced children
+        gpuProfiler.beginZone("Instanced");
+
         for (auto const &[id, info] : renderingManager->instancedRenderInfos) {
             if (id == "bbox" && !renderingManager->enableBoundingBoxes) continue;
             glPolygonMode(GL_FRONT_AND_BACK, id == "bbox" ? GL_LINE : GL_FILL);
             info->renderer->renderInstanced(getCamera(info->renderer->projection, i));
         }
 
+        gpuProfiler.endZone();
+
         /// Render all classic children
+        gpuProfiler.beginZone("Classic");
+
         for (auto const & info : renderingManager->renderInfos) {
             info->renderer->render(getCamera(info->renderer->projection, i));
         }
+
+        gpuProfiler.endZone();
     }
 }
 
@@ -131,6 +414,19 @@ void EngineRenderer::createFramebuffers() {
             std::cout << "Framebuffer is not complete!" << std::endl;
         }
     }
+
+    trackRenderTargets();
+}
+
+void EngineRenderer::trackRenderTargets() {
+    /// GL_RGB color texture and GL_DEPTH_COMPONENT renderbuffer, which drivers store as 24 bit depth padded to 4 bytes
+    size_t bytes = 0;
+
+    for (int i = 0; i < 2; i++) {
+        bytes += static_cast<size_t>(widths[i]) * static_cast<size_t>(heights[i]) * (3 + 4);
+    }
+
+    MemoryTracker::Instance().update(MemoryCategory::GPU_RENDER_TARGETS, renderTargetBytes, bytes);
 }
 
 void EngineRenderer::setTargetSize(const glm::vec2 & size, const int & idx) {
@@ -148,6 +444,8 @@ void EngineRenderer::setTargetSize(const glm::vec2 & size, const int & idx) {
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, widths[idx], heights[idx]);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
+    trackRenderTargets();
+
     perspectiveCameras[idx]->updateAspectRatio(size);
     ortographicCamera->updateSize(size);
 }
@@ -5,8 +5,11 @@
 #include <Rendering/Camera/OrtographicCamera/OrtographicCamera.h>
 #include <Rendering/Camera/PerspectiveCamera/PerspectiveCamera.h>
 #include <Scene/Scene.h>
+#include <Scene/CommandQueue/CommandQueue.h>
 
 #include "Rendering/RenderingManager/RenderingManager.h"
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Rendering/Culling/SceneCuller/SceneCuller.h>
 
 class EngineRenderer {
 
@@ -16,6 +19,31 @@ class EngineRenderer {
 
         std::shared_ptr<BaseCamera> getCamera(const Projection & projection, const int & idx);
 
+        bool backFrameReady = false;
+
+        SceneCuller sceneCuller;
+
+        /// Objects are registered directly until prepare(), then through CommandQueue
+        bool prepared = false;
+
+        /// Loaded models swapped in per frame, spreads buffer uploads of large scenes over several frames
+        static constexpr size_t MESH_UPLOADS_PER_FRAME = 8;
+
+        /// Registers object and its children. Render infos created for them are prepared later, all at once.
+        void spawnNow(const std::shared_ptr<GameObject> & object, std::vector<std::shared_ptr<RenderInfo>> & createdInfos);
+
+        void despawnNow(const std::shared_ptr<GameObject> & object);
+
+        /// Generates missing normals in parallel, then creates GL buffers
+        void prepareRenderInfos(const std::vector<std::shared_ptr<RenderInfo>> & infos);
+
+        const std::string viewportZoneNames[2] = { "Viewport 0", "Viewport 1" };
+
+        /// Bytes of framebuffer attachments reported to MemoryTracker
+        size_t renderTargetBytes = 0;
+
+        void trackRenderTargets();
+
     public:
         double widths[2] = {1.0, 1.0};
         double heights[2] = {1.0, 1.0};
@@ -31,8 +59,35 @@ class EngineRenderer {
 
         void addScene(const std::shared_ptr<Scene> & scene);
 
+        /// Registers object together with all of its children. After prepare() object is spawned.
+        void addObject(const std::shared_ptr<GameObject> & object);
+
+        /// Applies command buffers submitted since last call. Main thread, while no frame is being prepared.
+        /// Transforms and fields are set in order, then only final spawned state of each object is applied.
+        void applyCommands();
+
+        /// Replaces placeholders of models loaded in background and uploads their buffers.
+        /// Main thread, while no frame is being prepared.
+        void uploadLoadedMeshes();
+
+        /// Frees instanced render infos left without objects for a while (streamed out meshes).
+        /// Main thread, while no frame is being prepared.
+        void releaseEmptyInfos();
+
         void prepare();
 
+        void tick();
+
+        void updateCameras();
+
+        /// Culls and updates all objects, then gathers instance data into back frame.
+        /// Does not touch GL, so it may run on frame pipeline thread.
+        void prepareFrame(const FrustumPlanes & frustum);
+
+        /// Makes last prepared frame current
+        void swapFrames();
+
+        /// Submits current frame (GL thread only)
         void renderFrame();
 
         void createFramebuffers();
@@ -41,5 +96,6 @@ class EngineRenderer {
 
         void setBoundingBoxesEnabled(const bool & enabled);
 
-        void testFrustrum(const std::shared_ptr<RenderInfo> & info);
+        /// Spatial queries over rendered objects (picking), valid between prepared frames
+        const SceneCuller & getSceneCuller() const { return sceneCuller; }
 };
\ No newline at end of file
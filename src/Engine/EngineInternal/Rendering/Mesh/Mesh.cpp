@@ -1,42 +1,230 @@
 #include "Mesh/Mesh.h"
 
+#include <algorithm>
+
 #include <Utils/NormalsGenerator/NormalsGenerator.h>
+#include <Profiling/Profile.h>
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+#include <Rendering/Mesh/MeshCache/MeshCache.h>
+#include <Rendering/Mesh/ObjParser/ObjParser.h>
+#include <Utils/VertexWelder/VertexWelder.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MESH_BOUNDS_SSE 1
+#endif
+
+namespace {
+
+#ifdef MESH_BOUNDS_SSE
+    /// Four interleaved xyz vertices (three loads) transposed into x, y and z lanes
+    inline void loadVertices(const float * values, __m128 & x, __m128 & y, __m128 & z) {
+        __m128 a = _mm_loadu_ps(values);     // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps(values + 4); // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps(values + 8); // z2 x3 y3 z3
+
+        __m128 xy23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+        __m128 yz01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+        x = _mm_shuffle_ps(a, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm_shuffle_ps(yz01, c, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    inline float horizontalMin(const __m128 & v) {
+        __m128 m = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(m);
+    }
+
+    inline float horizontalMax(const __m128 & v) {
+        __m128 m = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtss_f32(m);
+    }
+#endif
+
+    /// Min and max over vertices, count is number of vertices (at least one)
+    void vertexRange(const float * values, const size_t & count, glm::vec3 & min, glm::vec3 & max) {
+        size_t i = 0;
+
+        min = max = glm::vec3(values[0], values[1], values[2]);
+
+#ifdef MESH_BOUNDS_SSE
+        if (count >= 4) {
+            __m128 minX = _mm_set1_ps(min.x), minY = _mm_set1_ps(min.y), minZ = _mm_set1_ps(min.z);
+            __m128 maxX = minX, maxY = minY, maxZ = minZ;
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 x, y, z;
+                loadVertices(values + i * 3, x, y, z);
+
+                minX = _mm_min_ps(minX, x);
+                minY = _mm_min_ps(minY, y);
+                minZ = _mm_min_ps(minZ, z);
+
+                maxX = _mm_max_ps(maxX, x);
+                maxY = _mm_max_ps(maxY, y);
+                maxZ = _mm_max_ps(maxZ, z);
+            }
+
+            min = glm::vec3(horizontalMin(minX), horizontalMin(minY), horizontalMin(minZ));
+            max = glm::vec3(horizontalMax(maxX), horizontalMax(maxY), horizontalMax(maxZ));
+        }
+#endif
+
+        for (; i < count; i++) {
+            glm::vec3 vertex(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]);
+            min = glm::min(min, vertex);
+            max = glm::max(max, vertex);
+        }
+    }
+
+    /// Largest squared distance of vertices from center
+    float maxDistanceSquared(const float * values, const size_t & count, const glm::vec3 & center) {
+        size_t i = 0;
+        float result = 0.0f;
+
+#ifdef MESH_BOUNDS_SSE
+        __m128 cx = _mm_set1_ps(center.x), cy = _mm_set1_ps(center.y), cz = _mm_set1_ps(center.z);
+        __m128 maxDistance = _mm_setzero_ps();
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 x, y, z;
+            loadVertices(values + i * 3, x, y, z);
+
+            x = _mm_sub_ps(x, cx);
+            y = _mm_sub_ps(y, cy);
+            z = _mm_sub_ps(z, cz);
+
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+            maxDistance = _mm_max_ps(maxDistance, distance);
+        }
+
+        result = horizontalMax(maxDistance);
+#endif
+
+        for (; i < count; i++) {
+            glm::vec3 offset = glm::vec3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]) - center;
+            result = std::max(result, glm::dot(offset, offset));
+        }
+
+        return result;
+    }
+}
 
 Mesh::Mesh(const std::string & path) {
+    /// Cooked by asset_cooker, text OBJ is parsed only when there is no cooked file or it is stale
+    if (MeshCache::load(*this, MeshCache::cookedPath(path), path)) return;
+
     loadFromFile(path);
 }
 
 Mesh::Mesh() {}
 
+Mesh::~Mesh() {
+    auto & tracker = MemoryTracker::Instance();
+    tracker.remove(MemoryCategory::MESH_GEOMETRY, trackedGeometryBytes);
+    tracker.remove(MemoryCategory::INSTANCE_DATA, trackedInstanceBytes);
+}
+
 void Mesh::loadFromFile(const std::string & path) {
+    PROFILE_FUNCTION();
 
     std::cout << "Loading: " << path << std::endl;
 
-    tinyobj::attrib_t attrib;
+    ObjData obj;
 
-    std::string warning;
-    std::string error;
+    if (!ObjParser::parse(path, obj)) return;
 
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
+    /// Unique position, texture coordinate and normal combinations become vertices, file normals and uvs are kept,
+    /// missing normals are generated over positions so UV seams stay smooth
+    VertexWelder::weld(obj, *this);
 
-    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warning, &error, path.c_str());
+    computeBounds();
+    updateMemoryUsage();
+}
 
-    if (!ret) {
-        if (!error.empty()) {
-            std::cerr << "Error: " << error << std::endl;
-        }
-    }
+void Mesh::computeBounds() {
+    PROFILE_FUNCTION();
+
+    auto values = getVertices();
+
+    size_t count = values.size / 3;
+
+    if (count == 0) return;
+
+    vertexRange(values.data, count, boundsMin, boundsMax);
+    boundsRadius = std::sqrt(maxDistanceSquared(values.data, count, getBoundsCenter()));
+
+    hasBounds = true;
+}
+
+void Mesh::assignGeometry(const Mesh & other) {
+    meshId = other.meshId;
+
+    vertices = other.vertices;
+    indices = other.indices;
+    uvs = other.uvs;
+    normals = other.normals;
 
-    if (!warning.empty()) {
-        std::cout << "Mesh: " << warning << std::endl;
+    /// Mapping is shared, cooked data is not copied
+    cookedFile = other.cookedFile;
+    cookedVertices = other.cookedVertices;
+    cookedIndices = other.cookedIndices;
+    cookedUvs = other.cookedUvs;
+    cookedNormals = other.cookedNormals;
+
+    boundsMin = other.boundsMin;
+    boundsMax = other.boundsMax;
+    boundsRadius = other.boundsRadius;
+    hasBounds = other.hasBounds;
+
+    residency = other.residency;
+    geometryReleased = other.geometryReleased;
+
+    prepared = false;
+
+    updateMemoryUsage();
+}
+
+void Mesh::releaseGeometry() {
+    if (residency == MeshResidency::KEEP || geometryReleased) return;
+
+    if (!hasBounds) {
+        computeBounds();
     }
 
-    vertices = attrib.vertices;
+    /// Swapping with empty vectors frees their capacity
+    std::vector<float>().swap(uvs);
+    std::vector<float>().swap(normals);
+    cookedUvs = MeshArray<float>();
+    cookedNormals = MeshArray<float>();
 
-    for (const auto & shape : shapes) {
-        for (const auto & index : shape.mesh.indices) {
-            indices.push_back((unsigned int) index.vertex_index);
-        }
+    /// Pages of mapped file are clean and shared with page cache - unused ones are dropped by the OS,
+    /// so collision data of cooked mesh is read from the mapping instead of being copied
+    if (residency == MeshResidency::COLLISION) {
+        updateMemoryUsage();
+        return;
     }
-}
\ No newline at end of file
+
+    std::vector<float>().swap(vertices);
+    std::vector<unsigned int>().swap(indices);
+
+    cookedFile.reset();
+    cookedVertices = MeshArray<float>();
+    cookedIndices = MeshArray<unsigned int>();
+
+    geometryReleased = true;
+
+    updateMemoryUsage();
+}
+
+void Mesh::updateMemoryUsage() {
+    size_t geometryBytes = (vertices.capacity() + uvs.capacity() + normals.capacity()) * sizeof(float) + indices.capacity() * sizeof(unsigned int);
+    size_t instanceBytes = modelMatrices.capacity() * sizeof(glm::mat4x4) + colorVectors.capacity() * sizeof(glm::vec4);
+
+    auto & tracker = MemoryTracker::Instance();
+    tracker.update(MemoryCategory::MESH_GEOMETRY, trackedGeometryBytes, geometryBytes);
+    tracker.update(MemoryCategory::INSTANCE_DATA, trackedInstanceBytes, instanceBytes);
+}
@@ -6,15 +6,39 @@
 #include <map>
 #include <thread>
 #include <limits>
-#include <tinyobj/tiny_obj_loader.h>
 
 #include <Engine/EngineInternal/Rendering/Projection.h>
 
 #include "Shading/Shader.h"
 #include "Utils/TextureLoader/TextureLoader.h"
 #include "MeshType.h"
+#include "MeshResidency.h"
 #include "Engine/EngineInternal/Scene/Transform.h"
+#include <Utils/MappedFile/MappedFile.h>
 
+/// Read-only view of mesh data, over owned vector or over mapped cooked file
+template<typename T>
+class MeshArray {
+
+    public:
+
+        const T * data = nullptr;
+        size_t size = 0;
+
+        MeshArray() = default;
+
+        MeshArray(const T * data, const size_t & size) : data(data), size(size) {}
+
+        MeshArray(const std::vector<T> & values) : data(values.data()), size(values.size()) {}
+
+        bool empty() const { return size == 0; }
+
+        const T & operator[](const size_t & index) const { return data[index]; }
+
+        const T * begin() const { return data; }
+
+        const T * end() const { return data + size; }
+};
 
 class Mesh {
     public:
@@ -25,14 +49,71 @@ class Mesh {
         std::vector<float> uvs;
         std::vector<float> normals;
 
+        /// Mesh loaded from cooked file (see MeshCache) reads its data straight from the mapping,
+        /// vectors above stay empty. Use getters below to read data of any mesh.
+        std::shared_ptr<MappedFile> cookedFile;
+        MeshArray<float> cookedVertices;
+        MeshArray<unsigned int> cookedIndices;
+        MeshArray<float> cookedUvs;
+        MeshArray<float> cookedNormals;
+
+        /// Object space bounds of vertices, computed once per mesh and stored in cooked files.
+        /// Bounding sphere is centered in the middle of the box.
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+        float boundsRadius = 0.0f;
+        bool hasBounds = false;
+
         std::vector<glm::mat4x4> modelMatrices;
         std::vector<glm::vec4> colorVectors;
 
         bool prepared = false;
 
+        MeshResidency residency = MeshResidency::DISCARD;
+
+        /// Geometry was freed after upload according to residency, MeshBuilder builds it again before next upload
+        bool geometryReleased = false;
+
+        /// Index count of GPU buffer, valid after CPU copy is released
+        size_t uploadedIndexCount = 0;
+
+        /// Bytes last reported to MemoryTracker
+        size_t trackedGeometryBytes = 0;
+        size_t trackedInstanceBytes = 0;
+
         Mesh();
 
         Mesh(const std::string & path);
 
+        /// Tracked sizes would be reported twice, use assignGeometry to copy geometry
+        Mesh(const Mesh & other) = delete;
+
+        Mesh & operator=(const Mesh & other) = delete;
+
+        ~Mesh();
+
         void loadFromFile(const std::string & path);
+
+        /// Computes box and sphere bounds from vertices, meshes without vertices stay without bounds
+        void computeBounds();
+
+        glm::vec3 getBoundsCenter() const { return (boundsMin + boundsMax) * 0.5f; }
+
+        /// Takes geometry, bounds and id of other mesh. Instance data is kept, so transforms targeting
+        /// this mesh stay valid. GL buffers have to be recreated by renderer.
+        void assignGeometry(const Mesh & other);
+
+        /// Frees data not needed by residency policy, called after upload. Bounds are computed first when missing.
+        void releaseGeometry();
+
+        /// Reports capacity of geometry and instance vectors to MemoryTracker, call after they change
+        void updateMemoryUsage();
+
+        MeshArray<float> getVertices() const { return cookedFile ? cookedVertices : MeshArray<float>(vertices); }
+
+        MeshArray<unsigned int> getIndices() const { return cookedFile ? cookedIndices : MeshArray<unsigned int>(indices); }
+
+        MeshArray<float> getUvs() const { return cookedFile ? cookedUvs : MeshArray<float>(uvs); }
+
+        MeshArray<float> getNormals() const { return cookedFile ? cookedNormals : MeshArray<float>(normals); }
 };
\ No newline at end of file
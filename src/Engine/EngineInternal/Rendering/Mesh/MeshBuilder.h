@@ -6,11 +6,46 @@
 #include <Rendering/Mesh/Primitives/Line.h>
 #include <Rendering/Mesh/Primitives/LineMeshComponent.h>
 #include <Rendering/Mesh/Primitives/Point.h>
+#include <Rendering/Mesh/MeshCache/MeshCache.h>
 
 class MeshBuilder {
     public:
+        /// Primitive cooked by asset_cooker, generated when there is no cooked file
+        template<typename T, typename... Args>
+        static std::shared_ptr<Mesh> buildPrimitive(const std::string & name, Args... args) {
+            auto cooked = std::make_shared<Mesh>();
+
+            if (MeshCache::load(*cooked, MeshCache::primitivePath(name))) {
+                return cooked;
+            }
+
+            auto mesh = std::make_shared<T>(args...);
+            mesh->computeBounds();
+            mesh->updateMemoryUsage();
+
+            return mesh;
+        }
+
+        /// Mesh prebuilt on component is returned. When its geometry was released after previous upload
+        /// (see MeshResidency), it is built again - cooked file is mapped again, so it is not decoded.
         static std::shared_ptr<Mesh> buildMesh(const std::shared_ptr<MeshComponent> & meshComponent) {
+            auto & prebuilt = meshComponent->mesh;
+
+            if (!prebuilt.get()) {
+                return createMesh(meshComponent);
+            }
+
+            /// Mesh is not uploaded, so nothing renders from it while geometry is replaced
+            if (prebuilt->geometryReleased && !prebuilt->prepared) {
+                prebuilt->assignGeometry(*createMesh(meshComponent));
+            }
+
+            return prebuilt;
+        }
+
+    private:
 
+        static std::shared_ptr<Mesh> createMesh(const std::shared_ptr<MeshComponent> & meshComponent) {
             std::shared_ptr<Mesh> mesh;
 
             if (meshComponent->path.empty()) {
@@ -19,13 +54,13 @@ class MeshBuilder {
                         mesh = std::make_shared<Line>();
                         break;
                     case QUAD:
-                        mesh = std::make_shared<Quad>();
+                        mesh = buildPrimitive<Quad>("quad");
                         break;
                     case CUBE:
-                        mesh = std::make_shared<Cube>();
+                        mesh = buildPrimitive<Cube>("cube");
                         break;
                     case SURFACE:
-                        mesh = std::make_shared<Surface>(300, 300);
+                        mesh = buildPrimitive<Surface>("surface_300x300", 300, 300);
                         break;
                     case POINT:
                         mesh = std::make_shared<Point>();
@@ -53,6 +88,13 @@ class MeshBuilder {
             }
 
             mesh->meshId = meshComponent->getMeshIdText();
+            mesh->residency = meshComponent->residency;
+            mesh->updateMemoryUsage();
+
+            /// Instances of the mesh derive their bounds from these, vertices are not walked again
+            if (!mesh->hasBounds) {
+                mesh->computeBounds();
+            }
 
             return mesh;
         }
@@ -0,0 +1,181 @@
+#include "MeshCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <Profiling/Profile.h>
+#include <Utils/NormalsGenerator/NormalsGenerator.h>
+
+#include "MeshFormat.h"
+
+using namespace MeshFormat;
+
+namespace {
+
+    struct SourceStamp {
+        uint64_t size = 0;
+        int64_t time = 0;
+    };
+
+    bool sourceStamp(const std::string & path, SourceStamp & stamp) {
+        std::error_code error;
+
+        auto size = std::filesystem::file_size(path, error);
+        if (error) return false;
+
+        auto time = std::filesystem::last_write_time(path, error);
+        if (error) return false;
+
+        stamp.size = static_cast<uint64_t>(size);
+        stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+
+        return true;
+    }
+
+    template<typename T>
+    Section placeSection(uint64_t & offset, const MeshArray<T> & values) {
+        offset = (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+
+        Section section { offset, values.size };
+        offset += values.size * sizeof(T);
+
+        return section;
+    }
+
+    template<typename T>
+    void writeSection(std::ofstream & stream, const Section & section, const MeshArray<T> & values) {
+        static const char padding[SECTION_ALIGNMENT] = {};
+
+        auto position = static_cast<uint64_t>(stream.tellp());
+        stream.write(padding, static_cast<std::streamsize>(section.offset - position));
+        stream.write(reinterpret_cast<const char *>(values.data), static_cast<std::streamsize>(values.size * sizeof(T)));
+    }
+
+    template<typename T>
+    bool mapSection(const MappedFile & file, const Section & section, MeshArray<T> & values) {
+        if (section.offset % alignof(T) != 0 || section.offset > file.getSize()) return false;
+        if (section.count > (file.getSize() - section.offset) / sizeof(T)) return false;
+
+        values = MeshArray<T>(reinterpret_cast<const T *>(file.getData() + section.offset), section.count);
+        return true;
+    }
+}
+
+std::string MeshCache::cookedPath(const std::string & sourcePath) {
+    return sourcePath + ".mesh";
+}
+
+std::string MeshCache::primitivePath(const std::string & meshId) {
+    return "../resources/cooked/" + meshId + ".mesh";
+}
+
+bool MeshCache::cook(Mesh & mesh, const std::string & path, const std::string & sourcePath) {
+    PROFILE_FUNCTION();
+
+    if (mesh.getNormals().empty()) {
+        NormalsGenerator::generate(&mesh);
+    }
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+
+    SourceStamp stamp;
+
+    if (!sourcePath.empty() && sourceStamp(sourcePath, stamp)) {
+        header.sourceSize = stamp.size;
+        header.sourceTime = stamp.time;
+    }
+
+    if (!mesh.hasBounds) {
+        mesh.computeBounds();
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        header.boundsMin[axis] = mesh.boundsMin[axis];
+        header.boundsMax[axis] = mesh.boundsMax[axis];
+    }
+
+    header.boundsRadius = mesh.boundsRadius;
+
+    auto vertices = mesh.getVertices();
+
+    uint64_t offset = sizeof(Header);
+
+    header.vertices = placeSection(offset, vertices);
+    header.indices = placeSection(offset, mesh.getIndices());
+    header.uvs = placeSection(offset, mesh.getUvs());
+    header.normals = placeSection(offset, mesh.getNormals());
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+    if (!stream) {
+        std::cerr << "MeshCache: cannot write " << path << std::endl;
+        return false;
+    }
+
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+    writeSection(stream, header.vertices, vertices);
+    writeSection(stream, header.indices, mesh.getIndices());
+    writeSection(stream, header.uvs, mesh.getUvs());
+    writeSection(stream, header.normals, mesh.getNormals());
+
+    return static_cast<bool>(stream);
+}
+
+bool MeshCache::load(Mesh & mesh, const std::string & path, const std::string & sourcePath) {
+    auto file = std::make_shared<MappedFile>(path);
+
+    if (!file->isOpen() || file->getSize() < sizeof(Header)) return false;
+
+    PROFILE_FUNCTION();
+
+    const auto & header = *reinterpret_cast<const Header *>(file->getData());
+
+    if (header.magic != MAGIC || header.version != VERSION) {
+        std::cout << "MeshCache: " << path << " has other version, cook it again" << std::endl;
+        return false;
+    }
+
+    SourceStamp stamp;
+
+    if (!sourcePath.empty() && sourceStamp(sourcePath, stamp) &&
+        (stamp.size != header.sourceSize || stamp.time != header.sourceTime)) {
+        std::cout << "MeshCache: " << path << " is stale, loading " << sourcePath << std::endl;
+        return false;
+    }
+
+    MeshArray<float> vertices, uvs, normals;
+    MeshArray<unsigned int> indices;
+
+    if (!mapSection(*file, header.vertices, vertices) || !mapSection(*file, header.indices, indices) ||
+        !mapSection(*file, header.uvs, uvs) || !mapSection(*file, header.normals, normals)) {
+        std::cerr << "MeshCache: " << path << " is malformed" << std::endl;
+        return false;
+    }
+
+    /// Indices pointing outside of vertex array would be read by GPU
+    size_t vertexCount = vertices.size / 3;
+
+    for (unsigned int index : indices) {
+        if (index >= vertexCount) {
+            std::cerr << "MeshCache: " << path << " is malformed" << std::endl;
+            return false;
+        }
+    }
+
+    mesh.cookedFile = file;
+    mesh.cookedVertices = vertices;
+    mesh.cookedIndices = indices;
+    mesh.cookedUvs = uvs;
+    mesh.cookedNormals = normals;
+
+    mesh.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    mesh.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    mesh.boundsRadius = header.boundsRadius;
+    mesh.hasBounds = true;
+
+    return true;
+}
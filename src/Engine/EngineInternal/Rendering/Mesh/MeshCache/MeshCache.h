@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include <Rendering/Mesh/Mesh.h>
+
+/// Cooked meshes - final vertex data, normals and bounds stored in binary file (see MeshFormat).
+///
+/// Files are produced offline by asset_cooker. At runtime cooked file is mapped and its arrays are uploaded
+/// to GPU straight from the mapping. Model is cooked next to its source, procedural primitives into resources/cooked.
+class MeshCache {
+
+    public:
+
+        static std::string cookedPath(const std::string & sourcePath);
+
+        static std::string primitivePath(const std::string & meshId);
+
+        /// Writes mesh (normals generated when missing) together with its bounds.
+        /// Size and time of source file are stored when sourcePath is given.
+        static bool cook(Mesh & mesh, const std::string & path, const std::string & sourcePath = "");
+
+        /// Maps cooked file into mesh. Fails when file is missing, has other version, is malformed
+        /// or is older than source file (when sourcePath is given).
+        static bool load(Mesh & mesh, const std::string & path, const std::string & sourcePath = "");
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+/// Layout of cooked mesh files (.mesh), written by asset_cooker.
+///
+/// Header is followed by 16 byte aligned arrays in the exact form they are uploaded to GPU: positions (xyz),
+/// 32 bit indices, texture coordinates (uv) and normals (xyz). Source size and modification time are stored,
+/// so cooked file older than its source is detected. Any change of layout or of data produced from sources
+/// increases VERSION.
+namespace MeshFormat {
+
+    static constexpr uint32_t MAGIC = 0x4853454D; // "MESH"
+    static constexpr uint32_t VERSION = 4;
+
+    static constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+    struct Section {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+
+        /// Zero for procedural primitives
+        uint64_t sourceSize;
+        int64_t sourceTime;
+
+        float boundsMin[3];
+        float boundsMax[3];
+        float boundsRadius;
+
+        /// Keeps sections 8 byte aligned
+        uint32_t padding;
+
+        Section vertices;
+        Section indices;
+        Section uvs;
+        Section normals;
+    };
+
+    static_assert(sizeof(Header) == 56 + 4 * sizeof(Section), "Header must not contain padding");
+}
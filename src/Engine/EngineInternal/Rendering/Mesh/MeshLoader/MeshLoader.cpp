@@ -0,0 +1,60 @@
+#include "MeshLoader.h"
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
+#include <Rendering/Mesh/MeshBuilder.h>
+#include <Utils/NormalsGenerator/NormalsGenerator.h>
+
+std::shared_future<std::shared_ptr<Mesh>> MeshLoader::load(const std::shared_ptr<MeshComponent> & meshComponent,
+                                                           const bool & generateNormals) {
+    std::string id = meshComponent->getMeshIdText();
+
+    auto promise = std::make_shared<std::promise<std::shared_ptr<Mesh>>>();
+    std::shared_future<std::shared_ptr<Mesh>> result;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto found = loading.find(id);
+
+        if (found != loading.end()) {
+            return found->second;
+        }
+
+        result = promise->get_future().share();
+        loading.emplace(id, result);
+    }
+
+    auto job = [this, meshComponent, generateNormals, promise, id]() {
+        PROFILE_SCOPE("MeshLoader::load");
+
+        auto mesh = MeshBuilder::buildMesh(meshComponent);
+
+        if (generateNormals && mesh->getNormals().empty()) {
+            NormalsGenerator::generate(mesh.get());
+        }
+
+        if (!mesh->hasBounds) {
+            mesh->computeBounds();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loading.erase(id);
+        }
+
+        promise->set_value(mesh);
+    };
+
+    auto & jobs = JobSystem::Instance();
+
+    /// Nobody would pick the job up until main thread waits for something
+    if (jobs.getWorkerCount() == 0) {
+        job();
+    }
+    else {
+        jobs.run(job);
+    }
+
+    return result;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <Rendering/Mesh/Mesh.h>
+#include <Components/MeshComponent/MeshComponent.h>
+
+/// Loads models on worker threads - file is parsed (or cooked file mapped), normals are generated
+/// and bounds computed in one job, so loads of different models run in parallel.
+/// Result carries no GL state, buffers are created by renderer on GL thread.
+///
+/// Requests of a model which is still loading share its load. Finished loads are forgotten,
+/// callers keep their futures as long as they need the mesh.
+class MeshLoader {
+
+    private:
+
+        std::mutex mutex;
+
+        std::unordered_map<std::string, std::shared_future<std::shared_ptr<Mesh>>> loading;
+
+        MeshLoader() = default;
+
+    public:
+
+        static MeshLoader & Instance() {
+            static MeshLoader instance;
+            return instance;
+        }
+
+        MeshLoader(const MeshLoader & other) = delete;
+
+        MeshLoader & operator=(const MeshLoader & other) = delete;
+
+        /// Component must reference model file. Normals are not generated when generateNormals is false.
+        std::shared_future<std::shared_ptr<Mesh>> load(const std::shared_ptr<MeshComponent> & meshComponent,
+                                                       const bool & generateNormals = true);
+
+        /// Models are loaded by this class, primitives are built directly
+        static bool isModel(const MeshComponent & meshComponent) {
+            return !meshComponent.mesh.get() && !meshComponent.path.empty();
+        }
+};
@@ -1,22 +1,34 @@
 #include "MeshRenderer.h"
 
+#include <algorithm>
+
 #include <Utils/NormalsGenerator/NormalsGenerator.h>
 #include <Rendering/Shading/ShaderPool.h>
+#include <Profiling/Profile.h>
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+
+MeshRenderer::~MeshRenderer() {
+    MemoryTracker::Instance().remove(MemoryCategory::INSTANCE_DATA, frameBytes);
+}
 
 void MeshRenderer::init(const std::shared_ptr<Mesh> & m) {
     mesh = m;
 }
 
 void MeshRenderer::prepare() {
+    PROFILE_FUNCTION();
 
     /// Verify if associated mesh exists
     if (!mesh.get()) {
         std::cerr << "MeshRenderer: Mesh is NULL" << std::endl;
+        return;
     }
 
     /// Ignore if mesh already prepared
-    if (mesh->prepared) {
-        std::cout << "Mesh already prepared" << std::endl;
+    if (mesh->prepared) return;
+
+    if (mesh->geometryReleased) {
+        std::cerr << "MeshRenderer: geometry of " << mesh->meshId << " was released after upload, it cannot be prepared again" << std::endl;
         return;
     }
 
@@ -39,9 +51,11 @@ void MeshRenderer::prepare() {
     }
 
     /// Generate normals for mesh if required
-    if (!disableNormals) {
-        NormalsGenerator::generate(mesh.get());
-    }
+    generateNormals();
+
+    mesh->updateMemoryUsage();
+
+    PROFILE_SCOPE("CreateBuffers");
 
     /// Prepare GPU buffers and initialize them
     CreateVertexAttributeObject();
@@ -55,8 +69,54 @@ void MeshRenderer::prepare() {
     glBindVertexArray(0);
 
     mesh->prepared = true;
+
+    /// Buffers are filled, CPU copy is kept only as far as residency asks
+    mesh->releaseGeometry();
+}
+
+
+void MeshRenderer::release() {
+    /// Buffers are created together with vertex array, renderer which was never prepared has none
+    if (vao != 0) {
+        GLuint buffers[] = { vbo, uvbo, nbo, model_matrices_vbo, color_vectors_vbo, ibo };
+
+        glDeleteBuffers(6, buffers);
+        glDeleteVertexArrays(1, &vao);
+    }
+
+    if (textureId != 0) {
+        TextureLoader::deleteTexture(textureId);
+    }
+
+    vao = vbo = uvbo = nbo = model_matrices_vbo = color_vectors_vbo = ibo = textureId = 0;
+    modelMatricesCapacity = colorVectorsCapacity = 0;
+
+    MemoryTracker::Instance().remove(MemoryCategory::GPU_GEOMETRY, gpuGeometryBytes);
+    gpuGeometryBytes = 0;
+
+    trackInstanceBuffers();
+
+    if (mesh.get()) {
+        mesh->prepared = false;
+    }
+}
+
+void MeshRenderer::generateNormals() {
+    if (disableNormals || !mesh.get() || !mesh->getNormals().empty()) return;
+
+    PROFILE_SCOPE("NormalsGenerator::generate");
+    NormalsGenerator::generate(mesh.get());
+}
+
+void MeshRenderer::trackGeometryBuffer(const size_t & bytes) {
+    MemoryTracker::Instance().add(MemoryCategory::GPU_GEOMETRY, bytes);
+    gpuGeometryBytes += bytes;
 }
 
+void MeshRenderer::trackInstanceBuffers() {
+    size_t bytes = modelMatricesCapacity * sizeof(glm::mat4x4) + colorVectorsCapacity * sizeof(glm::vec4);
+    MemoryTracker::Instance().update(MemoryCategory::GPU_INSTANCE_BUFFERS, gpuInstanceBytes, bytes);
+}
 
 void MeshRenderer::CreateVertexAttributeObject() {
     glGenVertexArrays(1, &vao);
@@ -64,16 +124,19 @@ void MeshRenderer::CreateVertexAttributeObject() {
 }
 
 void MeshRenderer::CreateIndexBuffer() {
-    auto indices = mesh->indices;
+    auto indices = mesh->getIndices();
 
     glGenBuffers(1, &ibo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size * sizeof(unsigned int), indices.data, GL_STATIC_DRAW);
+    trackGeometryBuffer(indices.size * sizeof(unsigned int));
+
+    mesh->uploadedIndexCount = indices.size;
 }
 
 void MeshRenderer::CreateVertexBuffer() {
 
-    auto vertices = mesh->vertices;
+    auto vertices = mesh->getVertices();
 
     if (vertices.empty()) {
         std::cerr << "ERROR: Vertices are empty" << std::endl;
@@ -81,7 +144,8 @@ void MeshRenderer::CreateVertexBuffer() {
     }
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size * sizeof(float), vertices.data, GL_STATIC_DRAW);
+    trackGeometryBuffer(vertices.size * sizeof(float));
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 }
@@ -89,7 +153,7 @@ void MeshRenderer::CreateVertexBuffer() {
 
 void MeshRenderer::CreateUVBuffer() {
 
-    auto uvs = mesh->uvs;
+    auto uvs = mesh->getUvs();
 
     if (uvs.empty()) {
         return;
@@ -97,14 +161,15 @@ void MeshRenderer::CreateUVBuffer() {
 
     glGenBuffers(1, &uvbo);
     glBindBuffer(GL_ARRAY_BUFFER, uvbo);
-    glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(float), uvs.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, uvs.size * sizeof(float), uvs.data, GL_STATIC_DRAW);
+    trackGeometryBuffer(uvs.size * sizeof(float));
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 }
 
 void MeshRenderer::CreateNormalsBuffer() {
 
-    auto normals = mesh->normals;
+    auto normals = mesh->getNormals();
 
     if (normals.empty()) {
         return;
@@ -112,14 +177,15 @@ void MeshRenderer::CreateNormalsBuffer() {
 
     glGenBuffers(1, &nbo);
     glBindBuffer(GL_ARRAY_BUFFER, nbo);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float), normals.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, normals.size * sizeof(float), normals.data, GL_STATIC_DRAW);
+    trackGeometryBuffer(normals.size * sizeof(float));
     glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 }
 
 void MeshRenderer::CreateModelMatricesBuffer() {
 
-    auto modelMatrices = mesh->modelMatrices;
+    const auto & modelMatrices = mesh->modelMatrices;
 
     if (modelMatrices.empty())  {
         return;
@@ -127,7 +193,9 @@ void MeshRenderer::CreateModelMatricesBuffer() {
 
     glGenBuffers(1, &model_matrices_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, model_matrices_vbo);
-    glBufferData(GL_ARRAY_BUFFER, modelMatrices.size() * sizeof(glm::mat4x4), nullptr, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, modelMatrices.size() * sizeof(glm::mat4x4), nullptr, GL_STREAM_DRAW);
+    modelMatricesCapacity = modelMatrices.size();
+    trackInstanceBuffers();
 
     glEnableVertexAttribArray(3);
     glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4x4), (void *) nullptr);
@@ -147,24 +215,54 @@ void MeshRenderer::CreateModelMatricesBuffer() {
     glVertexAttribDivisor(6, 1);
 }
 
-void MeshRenderer::UpdateModelMatrices() {
+void MeshRenderer::gatherFrame() {
+    auto & frame = backFrame();
 
-    auto modelMatrices = mesh->modelMatrices;
+    const auto & modelMatrices = mesh->modelMatrices;
+    const auto & colorVectors = mesh->colorVectors;
 
-    usedModelMatrices.clear();
+    frame.usedModelMatrices.clear();
+    frame.usedColorVectors.clear();
 
-    for (int usedMeshIndex : usedMeshIndexes) {
-        usedModelMatrices.push_back(modelMatrices[usedMeshIndex]);
+    for (int usedMeshIndex : frame.usedMeshIndexes) {
+        frame.usedModelMatrices.push_back(modelMatrices[usedMeshIndex]);
+        frame.usedColorVectors.push_back(colorVectors[usedMeshIndex]);
     }
 
+    size_t bytes = 0;
+
+    for (auto & f : frames) {
+        bytes += f.usedMeshIndexes.capacity() * sizeof(int) + f.usedModelMatrices.capacity() * sizeof(glm::mat4) +
+                 f.usedColorVectors.capacity() * sizeof(glm::vec4);
+    }
+
+    MemoryTracker::Instance().update(MemoryCategory::INSTANCE_DATA, frameBytes, bytes);
+}
+
+void MeshRenderer::UpdateModelMatrices() {
+    PROFILE_FUNCTION();
+
+    auto & usedModelMatrices = frames[frontFrame].usedModelMatrices;
+
     if (usedModelMatrices.empty()) {
         return;
     }
 
     glBindVertexArray(vao);
 
+    if (!model_matrices_vbo) {
+        glGenBuffers(1, &model_matrices_vbo);
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, model_matrices_vbo);
-    glBufferData(GL_ARRAY_BUFFER, usedModelMatrices.size() * sizeof(glm::mat4x4), usedModelMatrices.data(), GL_STREAM_DRAW);
+
+    if (usedModelMatrices.size() > modelMatricesCapacity) {
+        modelMatricesCapacity = std::max(usedModelMatrices.size(), modelMatricesCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, modelMatricesCapacity * sizeof(glm::mat4x4), nullptr, GL_STREAM_DRAW);
+        trackInstanceBuffers();
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, 0, usedModelMatrices.size() * sizeof(glm::mat4x4), usedModelMatrices.data());
 
     glEnableVertexAttribArray(3);
     glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4x4), (void *) nullptr);
@@ -186,7 +284,7 @@ void MeshRenderer::UpdateModelMatrices() {
 
 void MeshRenderer::CreateColorBuffer() {
 
-    auto colorVectors = mesh->colorVectors;
+    const auto & colorVectors = mesh->colorVectors;
 
     if (colorVectors.empty()) {
         std::cerr << "ERROR: Color vectors are empty" << std::endl;
@@ -195,7 +293,9 @@ void MeshRenderer::CreateColorBuffer() {
 
     glGenBuffers(1, &color_vectors_vbo);
     glBindBuffer(GL_ARRAY_BUFFER, color_vectors_vbo);
-    glBufferData(GL_ARRAY_BUFFER, colorVectors.size() * sizeof(glm::vec4), nullptr, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, colorVectors.size() * sizeof(glm::vec4), nullptr, GL_STREAM_DRAW);
+    colorVectorsCapacity = colorVectors.size();
+    trackInstanceBuffers();
 
     glEnableVertexAttribArray(7);
     glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void *) nullptr);
@@ -204,22 +304,28 @@ void MeshRenderer::CreateColorBuffer() {
 }
 
 void MeshRenderer::UpdateColorVectors() {
+    PROFILE_FUNCTION();
 
-    auto colorVectors = mesh->colorVectors;
-
-    usedColorVectors.clear();
-
-    for (int i = 0; i < usedMeshIndexes.size(); i++) {
-        usedColorVectors.push_back(colorVectors[usedMeshIndexes[i]]);
-    }
+    auto & usedColorVectors = frames[frontFrame].usedColorVectors;
 
     if (usedColorVectors.empty()) {
         return;
     }
 
     glBindVertexArray(vao);
+    if (!color_vectors_vbo) {
+        glGenBuffers(1, &color_vectors_vbo);
+    }
+
     glBindBuffer(GL_ARRAY_BUFFER, color_vectors_vbo);
-    glBufferData(GL_ARRAY_BUFFER, usedColorVectors.size() * sizeof(glm::vec4), usedColorVectors.data(), GL_STREAM_DRAW);
+
+    if (usedColorVectors.size() > colorVectorsCapacity) {
+        colorVectorsCapacity = std::max(usedColorVectors.size(), colorVectorsCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, colorVectorsCapacity * sizeof(glm::vec4), nullptr, GL_STREAM_DRAW);
+        trackInstanceBuffers();
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, 0, usedColorVectors.size() * sizeof(glm::vec4), usedColorVectors.data());
 
     glEnableVertexAttribArray(7);
     glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4), (void *) nullptr);
@@ -228,7 +334,12 @@ void MeshRenderer::UpdateColorVectors() {
 }
 
 void MeshRenderer::loadTexture(const char * path) {
-    textureId = TextureLoader::generateAndBindTexture(TextureLoader::loadTextureData(path));
+    auto info = TextureLoader::loadTextureData(path);
+
+    textureId = TextureLoader::generateAndBindTexture(info);
+
+    /// Pixels live in texture now
+    TextureLoader::freeTextureData(info);
 }
 
 void MeshRenderer::loadCubeMap(const std::vector<std::string> & paths) {
@@ -244,7 +355,7 @@ void MeshRenderer::render(const std::shared_ptr<BaseCamera> & camera) {
     shaderInit(shader);
     UpdateModelMatrices();
     UpdateColorVectors();
-    render(renderingMode, static_cast<int>(mesh->indices.size()));
+    render(renderingMode, static_cast<int>(mesh->uploadedIndexCount));
 }
 
 void MeshRenderer::renderInstanced(const std::shared_ptr<BaseCamera> & camera) {
@@ -255,7 +366,7 @@ void MeshRenderer::renderInstanced(const std::shared_ptr<BaseCamera> & camera) {
     shaderInit(shader);
     UpdateModelMatrices();
     UpdateColorVectors();
-    renderInstanced(renderingMode, static_cast<int>(mesh->indices.size()), usedMeshIndexes.size());
+    renderInstanced(renderingMode, static_cast<int>(mesh->uploadedIndexCount), frames[frontFrame].usedMeshIndexes.size());
 }
 
 void MeshRenderer::render(GLenum renderMode, int indicesCount) {
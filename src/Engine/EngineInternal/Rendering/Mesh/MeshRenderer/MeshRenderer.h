@@ -8,6 +8,13 @@
 #include <Engine/EngineInternal/Rendering/Camera/BaseCamera.h>
 #include <Engine/EngineInternal/Settings.h>
 
+/// Per frame instance data. Filled by frame preparation (possibly on other thread), consumed by GL thread
+struct MeshRendererFrame {
+    std::vector<int> usedMeshIndexes;
+    std::vector<glm::mat4> usedModelMatrices;
+    std::vector<glm::vec4> usedColorVectors;
+};
+
 class MeshRenderer : public Component {
 
     private:
@@ -24,6 +31,18 @@ class MeshRenderer : public Component {
 
         GLuint textureId = 0;
 
+        /// Instances which fit into instance buffers, grown by doubling so spawning does not reallocate every frame
+        size_t modelMatricesCapacity = 0;
+        size_t colorVectorsCapacity = 0;
+
+        /// Bytes reported to MemoryTracker
+        size_t gpuGeometryBytes = 0;
+        size_t gpuInstanceBytes = 0;
+        size_t frameBytes = 0;
+
+        void trackGeometryBuffer(const size_t & bytes);
+        void trackInstanceBuffers();
+
         void CreateVertexAttributeObject();
         void CreateIndexBuffer();
         void CreateVertexBuffer();
@@ -35,11 +54,14 @@ class MeshRenderer : public Component {
         void render(GLenum renderMode, int indicesCount);
         void renderInstanced(GLenum renderMode, int indicesCount, int instanceCount);
 
+        /// Double buffer - front is rendered while back is prepared
+        MeshRendererFrame frames[2];
+
+        int frontFrame = 0;
+
     public:
 
-        std::vector<int> usedMeshIndexes;
-        std::vector<glm::mat4> usedModelMatrices;
-        std::vector<glm::vec4> usedColorVectors;
+        ~MeshRenderer();
 
         //////////////////////////////// Shader /////////////////////////////////
         std::shared_ptr<Shader> shader;
@@ -78,6 +100,19 @@ class MeshRenderer : public Component {
 
         void prepare();
 
+        /// Deletes GL buffers and texture (GL thread only), mesh can be prepared again afterwards
+        void release();
+
+        /// CPU part of preparation, safe to run on worker threads
+        void generateNormals();
+
+        MeshRendererFrame & backFrame() { return frames[1 - frontFrame]; }
+
+        /// Copies matrices and colors of visible instances into back frame
+        void gatherFrame();
+
+        void swapFrames() { frontFrame = 1 - frontFrame; }
+
         void UpdateModelMatrices();
         void UpdateColorVectors();
 
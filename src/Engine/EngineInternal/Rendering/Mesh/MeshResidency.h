@@ -0,0 +1,13 @@
+#pragma once
+
+/// What stays in CPU memory after mesh is uploaded to GPU. Bounds are always kept.
+enum class MeshResidency {
+    /// All data stays, mesh can be uploaded again
+    KEEP,
+
+    /// Positions and indices stay for picking and collisions, uvs and normals are freed
+    COLLISION,
+
+    /// Geometry is freed
+    DISCARD
+};
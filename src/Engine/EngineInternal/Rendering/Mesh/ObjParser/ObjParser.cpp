@@ -0,0 +1,447 @@
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
+#include <Utils/MappedFile/MappedFile.h>
+
+namespace {
+
+    /// Attributes and triangles of one line-aligned part of file
+    struct Chunk {
+        const char * begin = nullptr;
+        const char * end = nullptr;
+
+        std::vector<float> positions;
+        std::vector<float> normals;
+        std::vector<float> texcoords;
+
+        std::vector<ObjIndex> indices;
+
+        /// Components of index counted back from this chunk's attributes (RELATIVE_* bits).
+        /// Filled only after first relative index is found.
+        std::vector<uint8_t> relative;
+        bool hasRelative = false;
+
+        bool valid = true;
+    };
+
+    const uint8_t RELATIVE_VERTEX = 1;
+    const uint8_t RELATIVE_TEXCOORD = 2;
+    const uint8_t RELATIVE_NORMAL = 4;
+
+    /// Powers exactly representable in double
+    const double powersOfTen[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    inline bool isBlank(const char & c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool isDigit(const char & c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline void skipBlank(const char *& p, const char * end) {
+        while (p < end && isBlank(*p)) p++;
+    }
+
+    /// Long mantissas, nan and inf - token is copied, mapped text is not null terminated
+    bool parseFloatSlow(const char * start, const char * end, const char *& p, float & value) {
+        char buffer[64];
+
+        size_t length = 0;
+
+        while (start + length < end && length < sizeof(buffer) - 1 && !isBlank(start[length]) && start[length] != '\n') {
+            buffer[length] = start[length];
+            length++;
+        }
+
+        buffer[length] = '\0';
+
+        char * parsedEnd = nullptr;
+        double parsed = std::strtod(buffer, &parsedEnd);
+
+        if (parsedEnd == buffer) return false;
+
+        p = start + (parsedEnd - buffer);
+        value = static_cast<float>(parsed);
+
+        return true;
+    }
+
+    /// Decimal float. Up to 19 significant digits are gathered into integer mantissa - when mantissa and
+    /// power of ten are both exact in double, single multiplication or division gives correctly rounded result.
+    bool parseFloat(const char *& p, const char * end, float & value) {
+        skipBlank(p, end);
+
+        const char * start = p;
+
+        bool negative = false;
+
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            p++;
+        }
+
+        uint64_t mantissa = 0;
+        int significantDigits = 0;
+        int exponent = 0;
+        bool anyDigit = false;
+        bool truncated = false;
+
+        while (p < end && isDigit(*p)) {
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                if (mantissa != 0) significantDigits++;
+            }
+            else {
+                truncated = true;
+                exponent++;
+            }
+
+            anyDigit = true;
+            p++;
+        }
+
+        if (p < end && *p == '.') {
+            p++;
+
+            while (p < end && isDigit(*p)) {
+                if (significantDigits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                    if (mantissa != 0) significantDigits++;
+                    exponent--;
+                }
+                else {
+                    truncated = true;
+                }
+
+                anyDigit = true;
+                p++;
+            }
+        }
+
+        if (!anyDigit) {
+            return parseFloatSlow(start, end, p, value);
+        }
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            const char * e = p + 1;
+
+            bool negativeExponent = false;
+
+            if (e < end && (*e == '-' || *e == '+')) {
+                negativeExponent = *e == '-';
+                e++;
+            }
+
+            if (e < end && isDigit(*e)) {
+                int exponentValue = 0;
+
+                while (e < end && isDigit(*e)) {
+                    if (exponentValue < 10000) {
+                        exponentValue = exponentValue * 10 + (*e - '0');
+                    }
+                    e++;
+                }
+
+                exponent += negativeExponent ? -exponentValue : exponentValue;
+                p = e;
+            }
+        }
+
+        if (truncated || mantissa > (uint64_t(1) << 53) || exponent < -22 || exponent > 22) {
+            return parseFloatSlow(start, end, p, value);
+        }
+
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+
+        value = static_cast<float>(negative ? -result : result);
+
+        return true;
+    }
+
+    bool parseInt(const char *& p, const char * end, int64_t & value) {
+        bool negative = false;
+
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            p++;
+        }
+
+        if (p >= end || !isDigit(*p)) return false;
+
+        int64_t result = 0;
+
+        while (p < end && isDigit(*p)) {
+            if (result < (int64_t(1) << 40)) {
+                result = result * 10 + (*p - '0');
+            }
+            p++;
+        }
+
+        value = negative ? -result : result;
+
+        return true;
+    }
+
+    /// One-based index becomes zero-based, negative index is kept relative to attributes parsed so far in chunk
+    bool resolveIndex(const int64_t & value, const size_t & count, int32_t & index, uint8_t & relative, const uint8_t & bit) {
+        if (value > 0 && value <= INT32_MAX) {
+            index = static_cast<int32_t>(value - 1);
+            return true;
+        }
+
+        if (value < 0 && -value <= INT32_MAX) {
+            index = static_cast<int32_t>(static_cast<int64_t>(count) + value);
+            relative |= bit;
+            return true;
+        }
+
+        return false;
+    }
+
+    void readFloats(const char * p, const char * end, std::vector<float> & values, const int & count) {
+        for (int i = 0; i < count; i++) {
+            float value = 0.0f;
+
+            /// Missing components are zero
+            if (p < end) {
+                parseFloat(p, end, value);
+            }
+
+            values.push_back(value);
+        }
+    }
+
+    /// Polygon corners are triangulated as fan
+    void readFace(const char * p, const char * end, Chunk & chunk, std::vector<ObjIndex> & corners, std::vector<uint8_t> & cornerRelative) {
+        corners.clear();
+        cornerRelative.clear();
+
+        while (true) {
+            skipBlank(p, end);
+
+            if (p >= end || *p == '#') break;
+
+            ObjIndex corner;
+            uint8_t relative = 0;
+
+            int64_t value;
+
+            if (!parseInt(p, end, value) || !resolveIndex(value, chunk.positions.size() / 3, corner.vertex, relative, RELATIVE_VERTEX)) {
+                chunk.valid = false;
+                return;
+            }
+
+            if (p < end && *p == '/') {
+                p++;
+
+                if (p < end && *p != '/') {
+                    if (!parseInt(p, end, value) || !resolveIndex(value, chunk.texcoords.size() / 2, corner.texcoord, relative, RELATIVE_TEXCOORD)) {
+                        chunk.valid = false;
+                        return;
+                    }
+                }
+
+                if (p < end && *p == '/') {
+                    p++;
+
+                    if (!parseInt(p, end, value) || !resolveIndex(value, chunk.normals.size() / 3, corner.normal, relative, RELATIVE_NORMAL)) {
+                        chunk.valid = false;
+                        return;
+                    }
+                }
+            }
+
+            corners.push_back(corner);
+            cornerRelative.push_back(relative);
+        }
+
+        for (size_t i = 1; i + 1 < corners.size(); i++) {
+            size_t triangle[3] = { 0, i, i + 1 };
+
+            for (auto & corner : triangle) {
+                if (cornerRelative[corner] != 0 && !chunk.hasRelative) {
+                    chunk.relative.assign(chunk.indices.size(), 0);
+                    chunk.hasRelative = true;
+                }
+
+                chunk.indices.push_back(corners[corner]);
+
+                if (chunk.hasRelative) {
+                    chunk.relative.push_back(cornerRelative[corner]);
+                }
+            }
+        }
+    }
+
+    void parseChunk(Chunk & chunk) {
+        PROFILE_SCOPE("ObjParser::parseChunk");
+
+        std::vector<ObjIndex> corners;
+        std::vector<uint8_t> cornerRelative;
+
+        const char * p = chunk.begin;
+        const char * end = chunk.end;
+
+        while (p < end) {
+            auto * newline = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            const char * lineEnd = newline ? newline : end;
+
+            skipBlank(p, lineEnd);
+
+            if (lineEnd - p >= 2) {
+                if (p[0] == 'v') {
+                    if (isBlank(p[1])) {
+                        readFloats(p + 2, lineEnd, chunk.positions, 3);
+                    }
+                    else if (p[1] == 'n' && lineEnd - p >= 3 && isBlank(p[2])) {
+                        readFloats(p + 3, lineEnd, chunk.normals, 3);
+                    }
+                    else if (p[1] == 't' && lineEnd - p >= 3 && isBlank(p[2])) {
+                        readFloats(p + 3, lineEnd, chunk.texcoords, 2);
+                    }
+                }
+                else if (p[0] == 'f' && isBlank(p[1])) {
+                    readFace(p + 2, lineEnd, chunk, corners, cornerRelative);
+                }
+            }
+
+            p = lineEnd + 1;
+        }
+    }
+
+    bool inRange(const int32_t & index, const size_t & count) {
+        return index >= 0 && static_cast<size_t>(index) < count;
+    }
+}
+
+bool ObjParser::parse(const std::string & path, ObjData & data) {
+    MappedFile file(path);
+
+    if (!file.isOpen()) {
+        std::cerr << "ObjParser: cannot open " << path << std::endl;
+        return false;
+    }
+
+    if (!parse(reinterpret_cast<const char *>(file.getData()), file.getSize(), data)) {
+        std::cerr << "ObjParser: invalid face in " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ObjParser::parse(const char * text, const size_t & size, ObjData & data) {
+    PROFILE_FUNCTION();
+
+    auto & jobs = JobSystem::Instance();
+
+    /// Few chunks per thread balance lines of different cost (faces are slower than vertices)
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(size / MIN_CHUNK_SIZE, (jobs.getWorkerCount() + 1) * 4));
+
+    std::vector<Chunk> chunks(chunkCount);
+
+    const char * end = text + size;
+    const char * begin = text;
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        chunks[i].begin = begin;
+
+        if (i + 1 == chunkCount) {
+            chunks[i].end = end;
+            break;
+        }
+
+        const char * target = std::max(begin, text + size * (i + 1) / chunkCount);
+        auto * newline = static_cast<const char *>(std::memchr(target, '\n', static_cast<size_t>(end - target)));
+
+        begin = newline ? newline + 1 : end;
+        chunks[i].end = begin;
+    }
+
+    jobs.parallelFor(0, chunks.size(), 1, [&chunks](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            parseChunk(chunks[i]);
+        }
+    });
+
+    /// Attribute counts of preceding chunks - offsets of relative indices and of chunk data in merged arrays
+    std::vector<size_t> positionOffsets(chunkCount + 1, 0);
+    std::vector<size_t> normalOffsets(chunkCount + 1, 0);
+    std::vector<size_t> texcoordOffsets(chunkCount + 1, 0);
+    std::vector<size_t> indexOffsets(chunkCount + 1, 0);
+
+    for (size_t i = 0; i < chunkCount; i++) {
+        if (!chunks[i].valid) return false;
+
+        positionOffsets[i + 1] = positionOffsets[i] + chunks[i].positions.size();
+        normalOffsets[i + 1] = normalOffsets[i] + chunks[i].normals.size();
+        texcoordOffsets[i + 1] = texcoordOffsets[i] + chunks[i].texcoords.size();
+        indexOffsets[i + 1] = indexOffsets[i] + chunks[i].indices.size();
+    }
+
+    data.positions.resize(positionOffsets[chunkCount]);
+    data.normals.resize(normalOffsets[chunkCount]);
+    data.texcoords.resize(texcoordOffsets[chunkCount]);
+    data.indices.resize(indexOffsets[chunkCount]);
+
+    size_t vertexCount = data.positions.size() / 3;
+    size_t normalCount = data.normals.size() / 3;
+    size_t texcoordCount = data.texcoords.size() / 2;
+
+    std::atomic<bool> valid { true };
+
+    jobs.parallelFor(0, chunks.size(), 1, [&](size_t first, size_t last) {
+        PROFILE_SCOPE("ObjParser::merge");
+
+        for (size_t i = first; i < last; i++) {
+            auto & chunk = chunks[i];
+
+            std::copy(chunk.positions.begin(), chunk.positions.end(), data.positions.begin() + positionOffsets[i]);
+            std::copy(chunk.normals.begin(), chunk.normals.end(), data.normals.begin() + normalOffsets[i]);
+            std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), data.texcoords.begin() + texcoordOffsets[i]);
+
+            auto vertexOffset = static_cast<int32_t>(positionOffsets[i] / 3);
+            auto normalOffset = static_cast<int32_t>(normalOffsets[i] / 3);
+            auto texcoordOffset = static_cast<int32_t>(texcoordOffsets[i] / 2);
+
+            ObjIndex * out = data.indices.data() + indexOffsets[i];
+
+            for (size_t j = 0; j < chunk.indices.size(); j++) {
+                ObjIndex index = chunk.indices[j];
+
+                if (chunk.hasRelative) {
+                    uint8_t relative = chunk.relative[j];
+
+                    if (relative & RELATIVE_VERTEX) index.vertex += vertexOffset;
+                    if (relative & RELATIVE_TEXCOORD) index.texcoord += texcoordOffset;
+                    if (relative & RELATIVE_NORMAL) index.normal += normalOffset;
+                }
+
+                if (!inRange(index.vertex, vertexCount)
+                    || (index.texcoord != -1 && !inRange(index.texcoord, texcoordCount))
+                    || (index.normal != -1 && !inRange(index.normal, normalCount))) {
+                    valid.store(false, std::memory_order_relaxed);
+                }
+
+                out[j] = index;
+            }
+
+            /// Chunk memory is released as soon as it is merged
+            chunk = Chunk();
+        }
+    });
+
+    return valid.load();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Corner of triangle, indexes point to attribute triplets (texcoord pairs). -1 when attribute is not given.
+struct ObjIndex {
+    int32_t vertex = -1;
+    int32_t texcoord = -1;
+    int32_t normal = -1;
+};
+
+/// Attributes of OBJ file, faces are triangulated as fans
+struct ObjData {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+
+    /// Three per triangle
+    std::vector<ObjIndex> indices;
+};
+
+/// Parser of OBJ geometry (v, vt, vn and f statements, everything else is skipped).
+///
+/// File is mapped and split into line-aligned chunks which are parsed in parallel, every chunk into its own arrays.
+/// Chunks are merged by copying into final arrays at offsets known from prefix sums of chunk counts,
+/// relative (negative) indices are resolved then. Floats are parsed without locale or strtod
+/// except for rare long or non-decimal values.
+class ObjParser {
+
+    public:
+
+        /// Chunks are not made smaller than this, small files are parsed on calling thread
+        static constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+        /// Fails when file cannot be read or has index out of range
+        static bool parse(const std::string & path, ObjData & data);
+
+        static bool parse(const char * text, const size_t & size, ObjData & data);
+};
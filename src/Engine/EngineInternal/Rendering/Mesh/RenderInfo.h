@@ -21,18 +21,45 @@ class RenderInfo {
             this->renderer->init(this->mesh);
 
             objects.push_back(child);
-            child->transform.modelMatrixIndex = objects.size() - 1;
-            child->transform.matricesRef = &mesh->modelMatrices;
-            mesh->modelMatrices.push_back(child->transform.modelMatrix);
+            child->transform().setMatrixTarget(&mesh->modelMatrices, objects.size() - 1);
+            mesh->modelMatrices.push_back(child->transform().calculateWorldMatrix(1.0f));
             mesh->colorVectors.push_back(meshRenderer->color);
+            mesh->updateMemoryUsage();
         }
 
 
         void addInstance(const std::shared_ptr<GameObjectBase> & child, const glm::vec4 & color) {
             objects.push_back(child);
-            child->transform.modelMatrixIndex = objects.size() - 1;
-            child->transform.matricesRef = &mesh->modelMatrices;
-            mesh->modelMatrices.push_back(child->transform.modelMatrix);
+            child->transform().setMatrixTarget(&mesh->modelMatrices, objects.size() - 1);
+            mesh->modelMatrices.push_back(child->transform().calculateWorldMatrix(1.0f));
             mesh->colorVectors.push_back(color);
+            mesh->updateMemoryUsage();
+        }
+
+        /// Last instance takes place of removed one, its transform is pointed to the new index
+        bool removeInstance(GameObjectBase * child) {
+            int index = child->transform().getMatrixIndex();
+
+            if (index < 0 || index >= static_cast<int>(objects.size()) || objects[index].get() != child) {
+                return false;
+            }
+
+            size_t last = objects.size() - 1;
+
+            if (static_cast<size_t>(index) != last) {
+                objects[index] = objects[last];
+                mesh->modelMatrices[index] = mesh->modelMatrices[last];
+                mesh->colorVectors[index] = mesh->colorVectors[last];
+
+                objects[index]->transform().setMatrixTarget(&mesh->modelMatrices, index);
+            }
+
+            objects.pop_back();
+            mesh->modelMatrices.pop_back();
+            mesh->colorVectors.pop_back();
+
+            child->transform().setMatrixTarget(nullptr, -1);
+
+            return true;
         }
 };
\ No newline at end of file
@@ -1,8 +1,17 @@
 #include "RenderingManager.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include <Profiling/Profile.h>
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Coroutines/TaskScheduler/TaskScheduler.h>
+#include <Engine/EngineInternal/Time.h>
+
 RenderingManager::RenderingManager() = default;
 
 void RenderingManager::preprocessScenes() {
+    PROFILE_FUNCTION();
 
     ///--------------------------------------------------------------------------------------
     ///Create render infos for each GameObject
@@ -10,46 +19,358 @@ void RenderingManager::preprocessScenes() {
 
     std::cout << "Children size: " << children.size() << std::endl;
 
-    for (auto & child : children) {
-        auto meshComponent = child->getComponent<MeshComponent>();
+    /// Meshes are built in parallel first, then assigned to render infos in scene order
+    std::map<std::string, size_t> instancedMeshIndexes;
+    std::vector<size_t> classicMeshIndexes;
+    std::vector<std::shared_ptr<MeshComponent>> meshComponents;
+
+    /// Models are loaded by worker jobs while primitives are built and objects registered, one load per file
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<Mesh>>> modelLoads;
+
+    auto & world = World::Instance();
+
+    /// Child of every entity index, World also holds entities of bounding boxes and other scenes
+    std::vector<int32_t> entityChildren;
+
+    for (size_t i = 0; i < children.size(); i++) {
+        auto & child = children[i];
+
+        if (!world.has<std::shared_ptr<MeshComponent>>(child->entity)) {
+            /// Scenes set transforms after construction, start interpolation from the final placement
+            child->transform().storePrevious();
+            continue;
+        }
+
+        /// Renderer is added before the query, adding component moves entity to another archetype
+        child->getComponentOrDefault<MeshRenderer>();
+
+        if (child->entity.index >= entityChildren.size()) {
+            entityChildren.resize(child->entity.index + 1, -1);
+        }
+
+        entityChildren[child->entity.index] = static_cast<int32_t>(i);
+    }
+
+    /// Components are gathered by one pass over archetype columns, in order of children
+    std::vector<std::shared_ptr<MeshComponent>> childMeshes(children.size());
+    std::vector<std::shared_ptr<MeshRenderer>> childRenderers(children.size());
+
+    world.each<Transform, std::shared_ptr<MeshComponent>, std::shared_ptr<MeshRenderer>>(
+            [&](const Entity & entity, Transform & transform, std::shared_ptr<MeshComponent> & meshComponent,
+                std::shared_ptr<MeshRenderer> & meshRenderer) {
+        if (entity.index >= entityChildren.size() || entityChildren[entity.index] < 0) return;
+
+        transform.storePrevious();
+
+        childMeshes[entityChildren[entity.index]] = meshComponent;
+        childRenderers[entityChildren[entity.index]] = meshRenderer;
+    });
+
+    for (size_t i = 0; i < children.size(); i++) {
+        auto & meshComponent = childMeshes[i];
         if (!meshComponent.get()) continue;
 
-        auto meshRenderer = child->getComponentOrDefault<MeshRenderer>();
+        auto & meshRenderer = childRenderers[i];
+
+        if (MeshLoader::isModel(*meshComponent)) {
+            if (modelLoads.count(meshComponent->path) == 0) {
+                modelLoads.emplace(meshComponent->path, MeshLoader::Instance().load(meshComponent));
+            }
+            continue;
+        }
 
         if (meshRenderer->instanced) {
             std::string id = meshRenderer->getShaderTypeStr() + "_" + meshComponent->getMeshIdText();
 
+            if (instancedRenderInfos.count(id) == 0 && instancedMeshIndexes.count(id) == 0) {
+                instancedMeshIndexes.insert(std::make_pair(id, meshComponents.size()));
+                meshComponents.push_back(meshComponent);
+            }
+        }
+        else {
+            classicMeshIndexes.push_back(meshComponents.size());
+            meshComponents.push_back(meshComponent);
+        }
+    }
 
-            if (instancedRenderInfos.count(id) == 0) {
-                auto mesh = MeshBuilder::buildMesh(meshComponent);
-                auto renderInfo = std::make_shared<RenderInfo>(mesh, child, meshRenderer);
+    std::vector<std::shared_ptr<Mesh>> meshes(meshComponents.size());
 
-                if (meshRenderer->enableBoundingBox) {
-                    addBoundingBox(mesh, child);
-                }
+    JobSystem::Instance().parallelFor(0, meshComponents.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            meshes[i] = MeshBuilder::buildMesh(meshComponents[i]);
+        }
+    });
 
-                instancedRenderInfos.insert(std::make_pair(id, renderInfo));
-            }
-            else {
-                if (meshRenderer->enableBoundingBox) {
-                    addBoundingBox(instancedRenderInfos[id]->mesh, child);
-                }
-                instancedRenderInfos[id]->addInstance(child, meshRenderer->color);
+    size_t classicIndex = 0;
+
+    /// GL buffers of all infos are created later by EngineRenderer::prepare
+    std::vector<std::shared_ptr<RenderInfo>> createdInfos;
+
+    for (size_t i = 0; i < children.size(); i++) {
+        auto & meshComponent = childMeshes[i];
+        if (!meshComponent.get()) continue;
+
+        auto & meshRenderer = childRenderers[i];
+
+        if (MeshLoader::isModel(*meshComponent)) {
+            registerObject(children[i], meshComponent, meshRenderer, nullptr, createdInfos, modelLoads[meshComponent->path]);
+            continue;
+        }
+
+        std::shared_ptr<Mesh> mesh;
+
+        if (meshRenderer->instanced) {
+            std::string id = meshRenderer->getShaderTypeStr() + "_" + meshComponent->getMeshIdText();
+
+            auto prebuilt = instancedMeshIndexes.find(id);
+
+            if (prebuilt != instancedMeshIndexes.end()) {
+                mesh = meshes[prebuilt->second];
             }
         }
         else {
-            auto mesh = MeshBuilder::buildMesh(meshComponent);
-            auto renderInfo = std::make_shared<RenderInfo>(mesh, child, meshRenderer);
+            mesh = meshes[classicMeshIndexes[classicIndex++]];
+        }
+
+        registerObject(children[i], meshComponent, meshRenderer, mesh, createdInfos);
+    }
+
+    logRenderMap();
+}
+
+std::shared_ptr<RenderInfo> RenderingManager::registerObject(const std::shared_ptr<GameObject> & child,
+                                                             const std::shared_ptr<MeshComponent> & meshComponent,
+                                                             const std::shared_ptr<MeshRenderer> & meshRenderer,
+                                                             std::shared_ptr<Mesh> mesh,
+                                                             std::vector<std::shared_ptr<RenderInfo>> & createdInfos,
+                                                             std::shared_future<std::shared_ptr<Mesh>> loading) {
+    std::shared_ptr<RenderInfo> info;
+
+    if (meshRenderer->instanced) {
+        std::string id = meshRenderer->getShaderTypeStr() + "_" + meshComponent->getMeshIdText();
+
+        auto found = instancedRenderInfos.find(id);
+
+        if (found != instancedRenderInfos.end()) {
+            info = found->second;
+            info->addInstance(child, meshRenderer->color);
+        }
+        else {
+            if (!mesh.get()) {
+                mesh = buildMesh(meshComponent, meshRenderer, loading);
+            }
 
-            renderInfos.emplace_back(renderInfo);
+            info = std::make_shared<RenderInfo>(mesh, child, meshRenderer);
+            instancedRenderInfos.insert(std::make_pair(id, info));
+            createdInfos.push_back(info);
 
-            if (meshRenderer->enableBoundingBox) {
-                addBoundingBox(mesh, child);
+            if (loading.valid()) {
+                pendingMeshes.push_back({ info, loading });
             }
         }
     }
+    else {
+        if (!mesh.get()) {
+            mesh = buildMesh(meshComponent, meshRenderer, loading);
+        }
 
-    logRenderMap();
+        info = std::make_shared<RenderInfo>(mesh, child, meshRenderer);
+        renderInfos.emplace_back(info);
+        createdInfos.push_back(info);
+
+        if (loading.valid()) {
+            pendingMeshes.push_back({ info, loading });
+        }
+    }
+
+    if (meshRenderer->enableBoundingBox) {
+        addBoundingBox(info->mesh, child, createdInfos);
+    }
+
+    objectInfos[child.get()] = info;
+
+    return info;
+}
+
+std::shared_ptr<Mesh> RenderingManager::buildMesh(const std::shared_ptr<MeshComponent> & meshComponent,
+                                                  const std::shared_ptr<MeshRenderer> & meshRenderer,
+                                                  std::shared_future<std::shared_ptr<Mesh>> & loading) {
+    if (!loading.valid() && !MeshLoader::isModel(*meshComponent)) {
+        return MeshBuilder::buildMesh(meshComponent);
+    }
+
+    if (!loading.valid()) {
+        loading = MeshLoader::Instance().load(meshComponent, !meshRenderer->disableNormals);
+    }
+
+    /// Cube keeps object visible and pickable until model geometry is swapped in
+    auto placeholder = MeshBuilder::buildPrimitive<Cube>("cube");
+    placeholder->meshId = meshComponent->getMeshIdText();
+
+    return placeholder;
+}
+
+void RenderingManager::takeLoadedMeshes(std::vector<std::shared_ptr<RenderInfo>> & loadedInfos, const size_t & maxCount) {
+    if (pendingMeshes.empty()) return;
+
+    PROFILE_FUNCTION();
+
+    size_t taken = 0;
+    size_t kept = 0;
+
+    for (size_t i = 0; i < pendingMeshes.size(); i++) {
+        auto & pending = pendingMeshes[i];
+
+        bool ready = taken < maxCount && pending.mesh.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+        if (!ready) {
+            if (kept != i) {
+                pendingMeshes[kept] = std::move(pending);
+            }
+
+            kept++;
+            continue;
+        }
+
+        auto & info = pending.info;
+        auto loaded = pending.mesh.get();
+
+        /// Classic info of removed object has already released its buffers
+        bool removed = !info->renderer->instanced && info->objects.empty();
+
+        if (removed || !loaded.get()) continue;
+
+        info->mesh->assignGeometry(*loaded);
+
+        for (auto & object : info->objects) {
+            BoundingBoxGenerator::fitBoundingBox(info->mesh, *object);
+        }
+
+        loadedInfos.push_back(info);
+        taken++;
+    }
+
+    pendingMeshes.resize(kept);
+}
+
+void RenderingManager::addChild(const std::shared_ptr<GameObject> & child) {
+    if (childIndexes.count(child.get()) > 0) return;
+
+    childIndexes[child.get()] = children.size();
+    children.push_back(child);
+}
+
+void RenderingManager::removeChild(const std::shared_ptr<GameObject> & child) {
+    auto found = childIndexes.find(child.get());
+    if (found == childIndexes.end()) return;
+
+    size_t index = found->second;
+    childIndexes.erase(found);
+
+    if (index + 1 != children.size()) {
+        children[index] = children.back();
+        childIndexes[children[index].get()] = index;
+    }
+
+    children.pop_back();
+}
+
+std::shared_ptr<RenderInfo> RenderingManager::addObject(const std::shared_ptr<GameObject> & child,
+                                                        std::vector<std::shared_ptr<RenderInfo>> & createdInfos) {
+    addChild(child);
+
+    child->transform().storePrevious();
+
+    auto meshComponent = child->getComponent<MeshComponent>();
+    if (!meshComponent.get()) return nullptr;
+
+    return registerObject(child, meshComponent, child->getComponentOrDefault<MeshRenderer>(), nullptr, createdInfos);
+}
+
+void RenderingManager::removeObject(const std::shared_ptr<GameObject> & child) {
+    removeChild(child);
+
+    auto found = objectInfos.find(child.get());
+    if (found == objectInfos.end()) return;
+
+    std::shared_ptr<RenderInfo> info = found->second;
+    objectInfos.erase(found);
+
+    info->removeInstance(child.get());
+
+    /// Empty instanced infos stay for a while (see releaseEmptyInfos), next object of the same mesh reuses their buffers
+    if (!info->renderer->instanced && info->objects.empty()) {
+        info->renderer->release();
+        renderInfos.erase(std::remove(renderInfos.begin(), renderInfos.end(), info), renderInfos.end());
+    }
+
+    if (child->boundingBox.get()) {
+        auto boundingBoxInfo = instancedRenderInfos.find("bbox");
+
+        if (boundingBoxInfo != instancedRenderInfos.end()) {
+            boundingBoxInfo->second->removeInstance(child->boundingBox.get());
+        }
+
+        /// Box is created again when object is added back
+        child->boundingBox = nullptr;
+    }
+}
+
+void RenderingManager::releaseEmptyInfos() {
+    frame++;
+
+    for (auto it = instancedRenderInfos.begin(); it != instancedRenderInfos.end();) {
+        auto & id = it->first;
+        auto & info = it->second;
+
+        /// Bounding box info is shared by boxes of all meshes
+        if (!info->objects.empty() || id == "bbox") {
+            if (!emptyInstancedInfos.empty()) {
+                emptyInstancedInfos.erase(id);
+            }
+
+            ++it;
+            continue;
+        }
+
+        auto since = emptyInstancedInfos.try_emplace(id, frame).first;
+
+        if (frame - since->second < EMPTY_INFO_FRAMES) {
+            ++it;
+            continue;
+        }
+
+        emptyInstancedInfos.erase(since);
+
+        /// Model still loading into the info is not needed anymore
+        const RenderInfo * released = info.get();
+
+        pendingMeshes.erase(std::remove_if(pendingMeshes.begin(), pendingMeshes.end(), [released](const PendingMesh & pending) {
+            return pending.info.get() == released;
+        }), pendingMeshes.end());
+
+        info->renderer->release();
+
+        it = instancedRenderInfos.erase(it);
+    }
+}
+
+void RenderingManager::tick() {
+    PROFILE_FUNCTION();
+
+    auto & transforms = TransformStorage::Instance();
+
+    float deltaTime = Time::Instance().getFixedDeltaTime();
+
+    transforms.storePrevious();
+
+    /// Behaviours are updated per type in batches, see SystemScheduler
+    SystemScheduler::Instance().update(World::Instance(), deltaTime);
+
+    /// Coroutines due in this tick
+    TaskScheduler::Instance().tick();
+
+    transforms.integrateAngularVelocity(deltaTime);
 }
 
 void RenderingManager::logRenderMap() {
@@ -67,14 +388,18 @@ void RenderingManager::logRenderMap() {
     }
 }
 
-void RenderingManager::addBoundingBox(const std::shared_ptr<Mesh> & mesh, const std::shared_ptr<GameObjectBase> & parent) {
+void RenderingManager::addBoundingBox(const std::shared_ptr<Mesh> & mesh, const std::shared_ptr<GameObjectBase> & parent,
+                                      std::vector<std::shared_ptr<RenderInfo>> & createdInfos) {
+    PROFILE_FUNCTION();
 
     auto bboxObj = BoundingBoxGenerator::calculateBoundingBox(mesh, parent);
     auto renderer = bboxObj->getComponent<MeshRenderer>();
     auto bboxMesh = MeshBuilder::buildMesh(bboxObj->getComponent<MeshComponent>());
 
     if (instancedRenderInfos.count("bbox") == 0) {
-        instancedRenderInfos.insert(std::make_pair("bbox", std::make_shared<RenderInfo>(bboxMesh, bboxObj, renderer)));
+        auto info = std::make_shared<RenderInfo>(bboxMesh, bboxObj, renderer);
+        instancedRenderInfos.insert(std::make_pair("bbox", info));
+        createdInfos.push_back(info);
     }
     else {
         instancedRenderInfos["bbox"]->addInstance(bboxObj, renderer->color);
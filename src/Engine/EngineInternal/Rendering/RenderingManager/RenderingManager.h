@@ -1,8 +1,12 @@
 #pragma once
 
+#include <future>
+#include <unordered_map>
+
 #include <Scene/GameObject/GameObject.h>
 #include <Rendering/Mesh/MeshBuilder.h>
 #include <Rendering/Mesh/RenderInfo.h>
+#include <Rendering/Mesh/MeshLoader/MeshLoader.h>
 #include <Rendering/Camera/PerspectiveCamera/PerspectiveCamera.h>
 #include <PhysicsEngine/PhysicsEngine.h>
 #include <Utils/BoundingBoxGenerator/BoundingBoxGenerator.h>
@@ -12,7 +16,41 @@ class RenderingManager {
 
     private:
 
-        void addBoundingBox(const std::shared_ptr<Mesh> & mesh, const std::shared_ptr<GameObjectBase> & parent);
+        /// Position of every child, children are swap-removed
+        std::unordered_map<const GameObject *, size_t> childIndexes;
+
+        /// Render info of every registered object
+        std::unordered_map<const GameObjectBase *, std::shared_ptr<RenderInfo>> objectInfos;
+
+        /// Render info drawing placeholder until its model is loaded
+        struct PendingMesh {
+            std::shared_ptr<RenderInfo> info;
+            std::shared_future<std::shared_ptr<Mesh>> mesh;
+        };
+
+        std::vector<PendingMesh> pendingMeshes;
+
+        /// Frame in which instanced info lost its last object, by info id
+        std::unordered_map<std::string, uint64_t> emptyInstancedInfos;
+
+        /// Number of releaseEmptyInfos calls
+        uint64_t frame = 0;
+
+        void addBoundingBox(const std::shared_ptr<Mesh> & mesh, const std::shared_ptr<GameObjectBase> & parent,
+                            std::vector<std::shared_ptr<RenderInfo>> & createdInfos);
+
+        /// Builds primitive, models get placeholder cube and their load is started (or given one is used)
+        std::shared_ptr<Mesh> buildMesh(const std::shared_ptr<MeshComponent> & meshComponent,
+                                        const std::shared_ptr<MeshRenderer> & meshRenderer,
+                                        std::shared_future<std::shared_ptr<Mesh>> & loading);
+
+        /// Adds object as instance of existing render info or creates new one. Mesh is built when not given.
+        std::shared_ptr<RenderInfo> registerObject(const std::shared_ptr<GameObject> & child,
+                                                   const std::shared_ptr<MeshComponent> & meshComponent,
+                                                   const std::shared_ptr<MeshRenderer> & meshRenderer,
+                                                   std::shared_ptr<Mesh> mesh,
+                                                   std::vector<std::shared_ptr<RenderInfo>> & createdInfos,
+                                                   std::shared_future<std::shared_ptr<Mesh>> loading = {});
 
     public:
         bool physicsEnabled = false;
@@ -28,7 +66,39 @@ class RenderingManager {
 
         RenderingManager();
 
+        void addChild(const std::shared_ptr<GameObject> & child);
+
+        void removeChild(const std::shared_ptr<GameObject> & child);
+
+        bool contains(const GameObject * child) const { return childIndexes.count(child) > 0; }
+
+        /// Registers all children at once, meshes are built in parallel.
+        /// Models are loaded in background, until then they are rendered as placeholders.
         void preprocessScenes();
 
+        /// Moves geometry of at most maxCount finished model loads into their render infos and refits bounds
+        /// of their objects. Returned infos need their GL buffers recreated.
+        void takeLoadedMeshes(std::vector<std::shared_ptr<RenderInfo>> & loadedInfos, const size_t & maxCount);
+
+        size_t getPendingMeshCount() const { return pendingMeshes.size(); }
+
+        /// Registers single object after scenes were preprocessed. Infos created for it (new mesh, first bounding box)
+        /// are appended to createdInfos and need GL preparation. Returns info rendering the object, if any.
+        std::shared_ptr<RenderInfo> addObject(const std::shared_ptr<GameObject> & child,
+                                              std::vector<std::shared_ptr<RenderInfo>> & createdInfos);
+
+        /// Swap-removes object (and its bounding box) from instance arrays
+        void removeObject(const std::shared_ptr<GameObject> & child);
+
+        /// Frames instanced info stays without objects, so objects leaving and coming back reuse its buffers
+        static constexpr uint64_t EMPTY_INFO_FRAMES = 300;
+
+        /// Releases buffers and mesh of instanced infos which have been empty for EMPTY_INFO_FRAMES calls.
+        /// Called once per frame on main thread, while no frame is being prepared.
+        void releaseEmptyInfos();
+
+        /// Runs single fixed simulation step on all scene objects
+        void tick();
+
         void logRenderMap();
 };
\ No newline at end of file
@@ -10,10 +10,10 @@
 std::shared_ptr<Scene> baseEngineScene() {
     std::shared_ptr<Scene> scene = std::make_shared<Scene>();
 
-    std::shared_ptr<MeshComponent> skyboxMesh = std::make_shared<MeshComponent>();
+    std::shared_ptr<MeshComponent> skyboxMesh = makePooled<MeshComponent>();
     skyboxMesh->meshType = CUBE;
 
-    std::shared_ptr<MeshRenderer> skyboxMeshRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<MeshRenderer> skyboxMeshRenderer = makePooled<MeshRenderer>();
     skyboxMeshRenderer->frustumCulling = false;
     skyboxMeshRenderer->enableBoundingBox = false;
     skyboxMeshRenderer->shaderType = TEXTURE_CUBE;
@@ -26,69 +26,69 @@ std::shared_ptr<Scene> baseEngineScene() {
             "../resources/textures/skybox/back.jpg"
     };
 
-    std::shared_ptr<GameObject> skyBoxObject = std::make_shared<GameObject>();
+    std::shared_ptr<GameObject> skyBoxObject = makePooled<GameObject>();
     skyBoxObject->addComponent(skyboxMesh);
     skyBoxObject->addComponent(skyboxMeshRenderer);
-    skyBoxObject->transform.scale = glm::vec3(10000.0f);
+    skyBoxObject->transform().setScale(glm::vec3(10000.0f));
 
-    std::shared_ptr<MeshComponent> gridQuad = std::make_shared<MeshComponent>();
+    std::shared_ptr<MeshComponent> gridQuad = makePooled<MeshComponent>();
     gridQuad->meshType = QUAD;
 
-    std::shared_ptr<MeshRenderer> gridQuadRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<MeshRenderer> gridQuadRenderer = makePooled<MeshRenderer>();
     gridQuadRenderer->shaderType = GRID;
     gridQuadRenderer->texture = "../resources/textures/texture_white.bmp";
     gridQuadRenderer->enableBoundingBox = true;
     gridQuadRenderer->frustumCulling = false;
 
-    std::shared_ptr<GameObject> gridObject = std::make_shared<GameObject>();
+    std::shared_ptr<GameObject> gridObject = makePooled<GameObject>();
     gridObject->addComponent(gridQuad);
     gridObject->addComponent(gridQuadRenderer);
 
-    gridObject->transform.scale = glm::vec3(100.0f, 100.0f, 100.0f);
-    gridObject->transform.rotation = glm::vec3(glm::radians(90.0), 0.0f, 0.0f);
+    gridObject->transform().setScale(glm::vec3(100.0f, 100.0f, 100.0f));
+    gridObject->transform().setRotation(glm::vec3(glm::radians(90.0), 0.0f, 0.0f));
 
-    std::shared_ptr<LineMeshComponent> axisX = std::make_shared<LineMeshComponent>();
+    std::shared_ptr<LineMeshComponent> axisX = makePooled<LineMeshComponent>();
     axisX->start = glm::vec3(-20.0f, 0.0f, 0.0f);
     axisX->end = glm::vec3(20.0f, 0.0f, 0.0f);
 
-    std::shared_ptr<MeshRenderer> axisXRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<MeshRenderer> axisXRenderer = makePooled<MeshRenderer>();
     axisXRenderer->renderingMode = GL_LINES;
     axisXRenderer->shaderType = AMBIENT;
     axisXRenderer->color = glm::vec4(0.0f, 1.0, 0.0, 1.0);
     axisXRenderer->enableBoundingBox = false;
     axisXRenderer->frustumCulling = false;
 
-    std::shared_ptr<GameObject> axisXObject = std::make_shared<GameObject>();
+    std::shared_ptr<GameObject> axisXObject = makePooled<GameObject>();
     axisXObject->addComponent(axisX);
     axisXObject->addComponent(axisXRenderer);
 
-    std::shared_ptr<LineMeshComponent> axisY = std::make_shared<LineMeshComponent>();
+    std::shared_ptr<LineMeshComponent> axisY = makePooled<LineMeshComponent>();
     axisY->start = glm::vec3(0.0f, -20.0f, 0.0f);
     axisY->end = glm::vec3(0.0f, 20.0f, 0.0f);
 
-    std::shared_ptr<MeshRenderer> axisYRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<MeshRenderer> axisYRenderer = makePooled<MeshRenderer>();
     axisYRenderer->renderingMode = GL_LINES;
     axisYRenderer->shaderType = AMBIENT;
     axisYRenderer->color = glm::vec4(1.0f, 0.0, 0.0, 1.0);
     axisYRenderer->enableBoundingBox = false;
     axisYRenderer->frustumCulling = false;
 
-    std::shared_ptr<GameObject> axisYObject = std::make_shared<GameObject>();
+    std::shared_ptr<GameObject> axisYObject = makePooled<GameObject>();
     axisYObject->addComponent(axisY);
     axisYObject->addComponent(axisYRenderer);
 
-    std::shared_ptr<LineMeshComponent> axisZ = std::make_shared<LineMeshComponent>();
+    std::shared_ptr<LineMeshComponent> axisZ = makePooled<LineMeshComponent>();
     axisZ->start = glm::vec3(0.0f, 0.0f, -20.0f);
     axisZ->end = glm::vec3(0.0f, 0.0f, 20.0f);
 
-    std::shared_ptr<MeshRenderer> axisZRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<MeshRenderer> axisZRenderer = makePooled<MeshRenderer>();
     axisZRenderer->renderingMode = GL_LINES;
     axisZRenderer->shaderType = AMBIENT;
     axisZRenderer->color = glm::vec4(0.0f, 0.0, 1.0, 1.0);
     axisZRenderer->enableBoundingBox = false;
     axisZRenderer->frustumCulling = false;
 
-    std::shared_ptr<GameObject> axisZObject = std::make_shared<GameObject>();
+    std::shared_ptr<GameObject> axisZObject = makePooled<GameObject>();
     axisZObject->addComponent(axisZ);
     axisZObject->addComponent(axisZRenderer);
 
@@ -5,9 +5,9 @@
 class BoundingBoxObject : public GameObjectBase {
     public:
 
-        std::shared_ptr<GameObjectBase> parent;
+        /// Parent owns the box through its boundingBox
+        GameObjectBase * parent = nullptr;
 
+        /// Transform is a child of parent's transform - box follows it without any copying
         void update(const bool & refreshMatrices) override;
-
-        virtual void update(const Transform & t, const BoundingBox & bb, const bool & refreshMatrices) override;
 };
\ No newline at end of file
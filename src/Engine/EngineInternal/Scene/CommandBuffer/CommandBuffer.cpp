@@ -0,0 +1,36 @@
+#include "CommandBuffer.h"
+
+#include <Scene/CommandQueue/CommandQueue.h>
+
+CommandBuffer::~CommandBuffer() {
+    submit();
+}
+
+void CommandBuffer::spawn(const std::shared_ptr<GameObject> & object) {
+    commands.push_back({ Command::Type::SPAWN, object });
+}
+
+void CommandBuffer::spawn(std::function<std::shared_ptr<GameObject>()> create) {
+    Command command { Command::Type::SPAWN };
+    command.create = std::move(create);
+
+    commands.push_back(std::move(command));
+}
+
+void CommandBuffer::destroy(const std::shared_ptr<GameObject> & object) {
+    commands.push_back({ Command::Type::DESTROY, object });
+}
+
+void CommandBuffer::setTransform(const std::shared_ptr<GameObject> & object,
+                                 const glm::vec3 & position,
+                                 const glm::quat & orientation,
+                                 const glm::vec3 & scale) {
+    commands.push_back({ Command::Type::SET_TRANSFORM, object, position, orientation, scale });
+}
+
+void CommandBuffer::submit() {
+    if (commands.empty()) return;
+
+    CommandQueue::Instance().submit(std::move(commands));
+    commands.clear();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Scene/GameObject/GameObject.h>
+
+/// Scene changes recorded for later.
+///
+/// Buffer belongs to the thread recording it and takes no locks. submit() hands all recorded commands
+/// to CommandQueue in one lock-free push; engine applies them in one batched step between frames
+/// (EngineRenderer::applyCommands), in order of submission and recording.
+///
+/// World and TransformStorage are not synchronized, so game objects are created and released on main thread only.
+/// Other threads spawn through a factory, which is called on main thread when commands are applied.
+class CommandBuffer {
+
+    public:
+
+        struct Command {
+            enum class Type : uint8_t { SPAWN, DESTROY, SET_TRANSFORM, SET_FIELD };
+
+            Type type;
+
+            std::shared_ptr<GameObject> object;
+
+            glm::vec3 position = glm::vec3(0.0f);
+            glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            glm::vec3 scale = glm::vec3(1.0f);
+
+            std::function<void(GameObject &)> apply;
+
+            /// Creates object of spawn command recorded without one
+            std::function<std::shared_ptr<GameObject>()> create;
+        };
+
+    private:
+
+        std::vector<Command> commands;
+
+    public:
+
+        CommandBuffer() = default;
+
+        CommandBuffer(const CommandBuffer & other) = delete;
+
+        CommandBuffer & operator=(const CommandBuffer & other) = delete;
+
+        /// Unsubmitted commands are submitted
+        ~CommandBuffer();
+
+        /// Object (with children) is rendered from next frame. Object has to be created on main thread.
+        void spawn(const std::shared_ptr<GameObject> & object);
+
+        /// Object (with children) returned by create is rendered from next frame, create runs on main thread
+        void spawn(std::function<std::shared_ptr<GameObject>()> create);
+
+        /// Object (with children) is removed before next frame
+        void destroy(const std::shared_ptr<GameObject> & object);
+
+        void setTransform(const std::shared_ptr<GameObject> & object,
+                          const glm::vec3 & position,
+                          const glm::quat & orientation,
+                          const glm::vec3 & scale);
+
+        /// Assigns field of object's component, skipped when object has no such component
+        template<typename T, typename V>
+        void set(const std::shared_ptr<GameObject> & object, V T::* field, V value) {
+            Command command { Command::Type::SET_FIELD, object };
+
+            command.apply = [field, value = std::move(value)](GameObject & target) {
+                if (auto component = target.getComponent<T>()) {
+                    (*component).*field = value;
+                }
+            };
+
+            commands.push_back(std::move(command));
+        }
+
+        size_t size() const { return commands.size(); }
+
+        /// Passes recorded commands to engine, buffer is empty and can be reused afterwards
+        void submit();
+};
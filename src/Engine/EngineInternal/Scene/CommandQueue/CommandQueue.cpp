@@ -0,0 +1,33 @@
+#include "CommandQueue.h"
+
+#include <algorithm>
+
+CommandQueue::~CommandQueue() {
+    drain();
+}
+
+void CommandQueue::submit(std::vector<CommandBuffer::Command> && commands) {
+    auto * batch = new Batch { std::move(commands) };
+
+    batch->next = head.load(std::memory_order_relaxed);
+
+    while (!head.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+std::vector<std::vector<CommandBuffer::Command>> CommandQueue::drain() {
+    std::vector<std::vector<CommandBuffer::Command>> batches;
+
+    Batch * batch = head.exchange(nullptr, std::memory_order_acquire);
+
+    /// Stack holds newest batch first
+    while (batch) {
+        Batch * next = batch->next;
+        batches.push_back(std::move(batch->commands));
+        delete batch;
+        batch = next;
+    }
+
+    std::reverse(batches.begin(), batches.end());
+
+    return batches;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <Scene/CommandBuffer/CommandBuffer.h>
+
+/// Submitted command buffers waiting for the engine.
+///
+/// Submissions are pushed onto lock-free stack, so any thread can submit while another one drains.
+/// drain() takes the whole stack with one exchange and returns batches in order of submission.
+class CommandQueue {
+
+    private:
+
+        struct Batch {
+            std::vector<CommandBuffer::Command> commands;
+            Batch * next = nullptr;
+        };
+
+        std::atomic<Batch *> head { nullptr };
+
+        CommandQueue() = default;
+
+    public:
+
+        static CommandQueue & Instance() {
+            static CommandQueue instance;
+            return instance;
+        }
+
+        CommandQueue(const CommandQueue & other) = delete;
+
+        CommandQueue & operator=(const CommandQueue & other) = delete;
+
+        ~CommandQueue();
+
+        void submit(std::vector<CommandBuffer::Command> && commands);
+
+        /// Removes all submitted batches, oldest first
+        std::vector<std::vector<CommandBuffer::Command>> drain();
+
+        bool empty() const { return head.load(std::memory_order_relaxed) == nullptr; }
+};
@@ -1,28 +1,59 @@
 #include "GameObject.h"
 
-#include <Components/Behaviour/BehaviourComponent.h>
+#include <algorithm>
+
 #include <Rendering/Mesh/MeshRenderer/MeshRenderer.h>
 
 GameObject::GameObject(const glm::vec3 & position, const glm::vec3 & rotation, const glm::vec3 & scale) {
-    transform.position = position;
-    transform.rotation = rotation;
-    transform.scale = scale;
+    auto & t = transform();
+    t.setPosition(position);
+    t.setRotation(rotation);
+    t.setScale(scale);
+    t.storePrevious();
 }
 
-void GameObject::update(const bool & refreshMatrices) {
-    if (transform.dirty) {
-        if (refreshMatrices) {
-            transform.calculateModelMatrix();
-        }
+GameObject::GameObject(const Entity & created) : GameObjectBase(created) {}
+
+GameObject::~GameObject() {
+    for (auto & child : children) {
+        child->parent = nullptr;
+    }
+}
+
+void GameObject::addChild(const std::shared_ptr<GameObject> & child) {
+    if (child->parent == this) return;
 
-        if (boundingBox.get()) {
-            boundingBox->update(transform, bbox, refreshMatrices);
-        }
+    if (!child->transform().setParent(&transform())) return;
 
-        transform.dirty = false;
+    /// Reference may point into children of previous parent
+    std::shared_ptr<GameObject> attached = child;
+
+    if (attached->parent) {
+        auto & siblings = attached->parent->children;
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), attached), siblings.end());
     }
 
-    for (auto & component : components) {
-        component->Update();
+    attached->parent = this;
+    children.push_back(attached);
+}
+
+void GameObject::removeChild(const std::shared_ptr<GameObject> & child) {
+    auto it = std::find(children.begin(), children.end(), child);
+
+    if (it == children.end()) return;
+
+    child->transform().setParent(nullptr);
+    child->parent = nullptr;
+    children.erase(it);
+}
+
+void GameObject::update(const bool & refreshMatrices) {
+    /// Matrices are computed in batch by TransformStorage, hidden object keeps its dirty flag until it becomes visible
+    if (!refreshMatrices) return;
+
+    transform().markVisible();
+
+    if (boundingBox.get()) {
+        boundingBox->update(refreshMatrices);
     }
 }
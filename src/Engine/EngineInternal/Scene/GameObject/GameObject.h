@@ -6,8 +6,12 @@ class GameObject : public GameObjectBase {
 
     public:
 
+        /// Objects attached with addChild, their transforms are relative to this object
         std::vector<std::shared_ptr<GameObject>> children;
 
+        /// Object this one is attached to, nullptr for objects added directly to scene
+        GameObject * parent = nullptr;
+
         int rb_idx = -1;
 
         GameObject(
@@ -16,5 +20,17 @@ class GameObject : public GameObjectBase {
             const glm::vec3 & scale = glm::vec3(1.0f)
         );
 
+        /// Object over entity created in its final archetype, transform keeps state stored in entity
+        explicit GameObject(const Entity & created);
+
+        ~GameObject() override;
+
+        /// Attaches child to this object, detaching it from its previous parent.
+        /// Children are registered together with their parent when scene is added.
+        void addChild(const std::shared_ptr<GameObject> & child);
+
+        void removeChild(const std::shared_ptr<GameObject> & child);
+
+        /// Variable rate render step - refreshes interpolated matrices
         virtual void update(const bool & refreshMatrices);
 };
\ No newline at end of file
@@ -2,13 +2,28 @@
 #include <Engine/EngineInternal/Components/Behaviour/BehaviourComponent.h>
 #include "GameObjectBase.h"
 
-std::shared_ptr<Component> GameObjectBase::addComponent(const std::shared_ptr<Component> & component) {
+GameObjectBase::GameObjectBase()
+        : entity(World::Instance().create()),
+          transformView(Transform::view(*World::Instance().add(entity, Transform()))) {}
+
+GameObjectBase::GameObjectBase(const Entity & created)
+        : entity(created),
+          transformView(Transform::view(World::Instance().get<Transform>(entity))) {}
+
+GameObjectBase::~GameObjectBase() {
+    World::Instance().destroy(entity);
+}
+
+void GameObjectBase::registerComponent(const std::shared_ptr<Component> & component) {
 
     if (Component::isTypeOf<BehaviourComponent>(component)) {
-        Component::asType<BehaviourComponent>(component)->SetObject(this);
+        auto behaviour = Component::asType<BehaviourComponent>(component);
+
+        behaviour->SetObject(this);
+        SystemScheduler::Instance().queueStart(behaviour);
+        World::Instance().add(entity, BehaviourTag());
     }
 
     components.push_back(component);
+}
 
-    return components[components.size() - 1];
-}
\ No newline at end of file
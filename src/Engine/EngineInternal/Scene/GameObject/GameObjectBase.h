@@ -5,48 +5,106 @@
 #include <iostream>
 
 #include <Engine/EngineInternal/Components/Component.h>
+#include <Ecs/SystemScheduler/SystemScheduler.h>
+#include <Ecs/World/World.h>
+#include <Memory/ObjectPool/ObjectPool.h>
 #include <Rendering/BoundingBox.h>
 #include "Scene/Transform.h"
 
+class BehaviourComponent;
+
+/// Marks entities with at least one behaviour
+struct BehaviourTag {};
+
+/// Facade over entity in World::Instance().
+///
+/// Transform is stored by value in its archetype column, object keeps a view of its slot, so transform()
+/// needs no World lookup. First component of every kind (see ComponentKind) is stored in World as shared
+/// pointer, so getComponent is a lookup instead of scan - columns hold pointers, the components themselves
+/// are separate pooled objects. Base classes and further components of the same kind are found by scanning
+/// components in order of adding.
 class GameObjectBase {
 
     protected:
 
+        /// All components in order of adding
         std::vector<std::shared_ptr<Component>> components;
 
-    public:
-        bool culled = false;
+        void registerComponent(const std::shared_ptr<Component> & component);
 
-        Transform transform;
+    public:
+        Entity entity;
 
         BoundingBox bbox;
 
         std::shared_ptr<GameObjectBase> boundingBox;
 
-        std::shared_ptr<Component> addComponent(const std::shared_ptr<Component> & baseComponent);
+    private:
 
-        template<typename T>
-        bool hasComponent() {
-            for (auto & component : components) {
+        /// View of Transform in World column, initialized after entity
+        Transform transformView;
 
-                auto c = getComponent<T>();
+    public:
 
-                if (c.get()) {
-                    return true;
-                }
+        GameObjectBase();
+
+        /// Takes ownership of entity created in its final archetype (see World::create), entity must have Transform
+        explicit GameObjectBase(const Entity & created);
+
+        GameObjectBase(const GameObjectBase & other) = delete;
+
+        GameObjectBase & operator=(const GameObjectBase & other) = delete;
+
+        virtual ~GameObjectBase();
+
+        /// Shares slot with Transform of entity, valid for whole life of the object
+        Transform & transform() { return transformView; }
+
+        const Transform & transform() const { return transformView; }
+
+        /// Components of the same kind do not replace each other, getComponent returns the first one.
+        /// Only first behaviour of each type has its Update called by SystemScheduler.
+        template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+        std::shared_ptr<T> addComponent(const std::shared_ptr<T> & component) {
+            typedef typename ComponentKind<T>::Type Kind;
+
+            auto & world = World::Instance();
+
+            /// Empty column of entity created in bulk is filled in place
+            if (auto * stored = world.tryGet<std::shared_ptr<Kind>>(entity)) {
+                if (!*stored) *stored = component;
             }
+            else {
+                world.add<std::shared_ptr<Kind>>(entity, component);
+            }
+
+            registerComponent(component);
 
-            return false;
+            if constexpr (std::is_base_of<BehaviourComponent, T>::value) {
+                SystemScheduler::Instance().addBehaviour<T>();
+            }
+
+            return component;
+        }
+
+        template<typename T>
+        bool hasComponent() {
+            return getComponent<T>().get() != nullptr;
         }
 
         template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
         std::shared_ptr<T> getComponent() {
-            for (auto & component : components) {
+            typedef typename ComponentKind<T>::Type Kind;
 
-                auto c = std::dynamic_pointer_cast<T>(component);
+            if (auto * stored = World::Instance().tryGet<std::shared_ptr<Kind>>(entity)) {
+                if (auto component = castComponent<T>(*stored)) {
+                    return component;
+                }
+            }
 
-                if (c.get()) {
-                    return c;
+            for (auto & component : components) {
+                if (auto found = std::dynamic_pointer_cast<T>(component)) {
+                    return found;
                 }
             }
 
@@ -58,24 +116,24 @@ class GameObjectBase {
             auto component = getComponent<T>();
 
             if (!component.get()) {
-                return castComponent<T>(addComponent(std::make_shared<T>()));
+                return addComponent(makePooled<T>());
             }
 
             return component;
         }
 
-        template<typename T>
-        std::shared_ptr<T> castComponent(const std::shared_ptr<Component> & component) {
-            std::shared_ptr<T> t = std::dynamic_pointer_cast<T>(component);
-
-            if (t) {
-                return t;
+        template<typename T, typename K>
+        std::shared_ptr<T> castComponent(const std::shared_ptr<K> & component) {
+            if constexpr (std::is_same<T, K>::value) {
+                return component;
+            }
+            else {
+                return std::dynamic_pointer_cast<T>(component);
             }
-
-            return nullptr;
         }
 
+        /// True when any behaviour is attached - object may move on its own
+        bool hasBehaviours() const { return World::Instance().has<BehaviourTag>(entity); }
 
         virtual void update(const bool & refreshMatrices) = 0;
-        virtual void update(const Transform & t, const BoundingBox & bb, const bool & refreshMatrices) {}
-};
\ No newline at end of file
+};
@@ -1,6 +1,9 @@
 #include "GameObjectFactory.h"
 
-
+void GameObjectFactory::reserve(const size_t & count) {
+    reservePooled<GameObject, MeshComponent, MeshRenderer>(count);
+    TransformStorage::Instance().reserve(count);
+}
 
 std::shared_ptr<GameObject> GameObjectFactory::cube(
         const glm::vec3 & position,
@@ -8,11 +11,11 @@ std::shared_ptr<GameObject> GameObjectFactory::cube(
         const glm::vec3 & scale,
         const glm::vec4 & color) {
 
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(position, rotation, scale);
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(position, rotation, scale);
 
-    auto mesh = std::make_shared<MeshComponent>(CUBE);
+    auto mesh = makePooled<MeshComponent>(CUBE);
 
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    auto meshRenderer = makePooled<MeshRenderer>();
     meshRenderer->shaderType = PHONG;
     meshRenderer->color = color;
     meshRenderer->instanced = true;
@@ -26,10 +29,10 @@ std::shared_ptr<GameObject> GameObjectFactory::point(
         const glm::vec3 & position,
         const glm::vec4 & color) {
 
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(position);
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(position);
 
-    auto mesh = std::make_shared<MeshComponent>(POINT);
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    auto mesh = makePooled<MeshComponent>(POINT);
+    auto meshRenderer = makePooled<MeshRenderer>();
     meshRenderer->shaderType = AMBIENT;
     meshRenderer->color = color;
     meshRenderer->instanced = true;
@@ -44,10 +47,10 @@ std::shared_ptr<GameObject> GameObjectFactory::quad(
         const glm::vec3 & scale,
         const glm::vec4 & color) {
 
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(position, rotation, scale);
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(position, rotation, scale);
 
-    auto mesh = std::make_shared<MeshComponent>(QUAD);
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    auto mesh = makePooled<MeshComponent>(QUAD);
+    auto meshRenderer = makePooled<MeshRenderer>();
     meshRenderer->shaderType = AMBIENT;
     meshRenderer->color = color;
     meshRenderer->instanced = true;
@@ -64,9 +67,9 @@ std::shared_ptr<GameObject> GameObjectFactory::model(
         const glm::vec3 & scale,
         const glm::vec4 & color) {
 
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(position, rotation, scale);
-    auto mesh = std::make_shared<MeshComponent>(path);
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(position, rotation, scale);
+    auto mesh = makePooled<MeshComponent>(path);
+    auto meshRenderer = makePooled<MeshRenderer>();
     meshRenderer->shaderType = PHONG;
     meshRenderer->color = color;
     meshRenderer->instanced = true;
@@ -126,13 +129,13 @@ std::shared_ptr<GameObject> GameObjectFactory::surface(
         const glm::vec3 & scale,
         const glm::vec4 & color) {
 
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(position);
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(position);
 
     auto mesh = SurfaceMeshComponent::create();
     mesh->width = scale.x;
     mesh->height = scale.y;
 
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    auto meshRenderer = makePooled<MeshRenderer>();
     meshRenderer->shaderType = PHONG;
     meshRenderer->color = color;
 
@@ -148,10 +151,10 @@ GameObjectFactory::point(
         const glm::vec3 & rot,
         const glm::vec3 & scale,
         const glm::vec4 & color) {
-    std::shared_ptr<GameObject> obj = std::make_shared<GameObject>(pos, rot, scale);
+    std::shared_ptr<GameObject> obj = makePooled<GameObject>(pos, rot, scale);
 
-    auto mesh = std::make_shared<MeshComponent>(POINT);
-    auto meshRenderer = std::make_shared<MeshRenderer>();
+    auto mesh = makePooled<MeshComponent>(POINT);
+    auto meshRenderer = makePooled<MeshRenderer>();
 
     meshRenderer->renderingMode = GL_POINTS;
     meshRenderer->shaderType = AMBIENT;
@@ -6,6 +6,9 @@
 class GameObjectFactory {
 
     public:
+        /// Makes room for count objects with mesh and renderer, so scene built in bulk does not grow pools one by one
+        static void reserve(const size_t & count);
+
         static std::shared_ptr<GameObject> point(const glm::vec3 & pos, const glm::vec4 & color);
 
         static std::shared_ptr<GameObject> quad(
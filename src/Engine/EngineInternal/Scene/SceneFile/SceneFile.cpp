@@ -0,0 +1,409 @@
+#include "SceneFile.h"
+
+#include <fstream>
+#include <iostream>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <Components/Behaviour/RigidbodyComponent/Rigidbody.h>
+#include <Components/Behaviour/RotatorComponent/Rotator.h>
+#include <Profiling/Profile.h>
+#include <Scene/GameObjectFactory/GameObjectFactory.h>
+#include <Utils/MappedFile/MappedFile.h>
+
+#include "SceneFormat.h"
+
+using namespace SceneFormat;
+
+namespace {
+
+    struct SceneWriter {
+        std::vector<TransformRecord> transforms;
+        std::vector<int32_t> parents;
+        std::vector<MeshRecord> meshes;
+        std::vector<RendererRecord> renderers;
+        std::vector<RotatorRecord> rotators;
+        std::vector<RigidbodyRecord> rigidbodies;
+        std::vector<char> strings;
+        std::vector<uint32_t> paths;
+
+        std::unordered_map<std::string, uint32_t> stringOffsets;
+
+        size_t unsupportedMeshes = 0;
+
+        uint32_t addString(const std::string & text) {
+            auto found = stringOffsets.find(text);
+            if (found != stringOffsets.end()) return found->second;
+
+            auto offset = static_cast<uint32_t>(strings.size());
+            strings.insert(strings.end(), text.begin(), text.end());
+            strings.push_back('\0');
+
+            stringOffsets[text] = offset;
+            return offset;
+        }
+
+        void addObject(GameObject & object, const int32_t & parent) {
+            auto index = static_cast<uint32_t>(transforms.size());
+
+            auto & transform = object.transform();
+            glm::vec3 position = transform.getPosition();
+            glm::quat orientation = transform.getOrientation();
+            glm::vec3 scale = transform.getScale();
+            glm::vec3 pivot = transform.getPivot();
+
+            transforms.push_back({
+                { position.x, position.y, position.z },
+                { orientation.x, orientation.y, orientation.z, orientation.w },
+                { scale.x, scale.y, scale.z },
+                { pivot.x, pivot.y, pivot.z }
+            });
+
+            parents.push_back(parent);
+
+            if (auto mesh = object.getComponent<MeshComponent>()) {
+                /// Lines and surfaces keep generation parameters in derived components
+                if (typeid(*mesh) != typeid(MeshComponent)) {
+                    unsupportedMeshes++;
+                }
+
+                meshes.push_back({ index, static_cast<uint32_t>(mesh->meshType),
+                                   mesh->path.empty() ? NO_STRING : addString(mesh->path) });
+            }
+
+            if (auto renderer = object.getComponent<MeshRenderer>()) {
+                uint32_t flags = (renderer->instanced ? INSTANCED : 0u) |
+                                 (renderer->enableBoundingBox ? BOUNDING_BOX : 0u) |
+                                 (renderer->disableNormals ? DISABLE_NORMALS : 0u) |
+                                 (renderer->frustumCulling ? FRUSTUM_CULLING : 0u) |
+                                 (renderer->cubeMap ? CUBE_MAP : 0u);
+
+                auto & color = renderer->color;
+                auto firstPath = static_cast<uint32_t>(paths.size());
+
+                for (auto & texturePath : renderer->paths) {
+                    paths.push_back(addString(texturePath));
+                }
+
+                renderers.push_back({ index, static_cast<uint32_t>(renderer->shaderType),
+                                      static_cast<uint32_t>(renderer->projection), renderer->renderingMode, flags,
+                                      renderer->texture ? addString(renderer->texture) : NO_STRING,
+                                      firstPath, static_cast<uint32_t>(renderer->paths.size()),
+                                      { color.x, color.y, color.z, color.w } });
+            }
+
+            if (auto rotator = object.getComponent<Rotator>()) {
+                rotators.push_back({ index, { rotator->speed.x, rotator->speed.y, rotator->speed.z } });
+            }
+
+            if (auto rigidbody = object.getComponent<Rigidbody>()) {
+                rigidbodies.push_back({ index, rigidbody->mass, rigidbody->restitution });
+            }
+
+            for (auto & child : object.children) {
+                addObject(*child, static_cast<int32_t>(index));
+            }
+        }
+    };
+
+    template<typename T>
+    Section placeSection(uint64_t & offset, const std::vector<T> & records) {
+        offset = (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+
+        Section section { offset, records.size() };
+        offset += records.size() * sizeof(T);
+
+        return section;
+    }
+
+    template<typename T>
+    void writeSection(std::ofstream & stream, const Section & section, const std::vector<T> & records) {
+        static const char padding[SECTION_ALIGNMENT] = {};
+
+        auto position = static_cast<uint64_t>(stream.tellp());
+        stream.write(padding, static_cast<std::streamsize>(section.offset - position));
+        stream.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(T)));
+    }
+
+    /// Records of section, nullptr when section does not fit into file or is misaligned
+    template<typename T>
+    const T * sectionData(const MappedFile & file, const Section & section) {
+        if (section.offset % alignof(T) != 0 || section.offset > file.getSize()) return nullptr;
+        if (section.count > (file.getSize() - section.offset) / sizeof(T)) return nullptr;
+
+        return reinterpret_cast<const T *>(file.getData() + section.offset);
+    }
+
+    /// Sparse component section must be sorted by object and reference existing objects
+    template<typename T>
+    bool validObjects(const T * records, const uint64_t & count, const uint64_t & objectCount) {
+        for (uint64_t i = 0; i < count; i++) {
+            if (records[i].object >= objectCount || (i > 0 && records[i].object <= records[i - 1].object)) return false;
+        }
+
+        return true;
+    }
+
+    /// Components of loaded object - sets are indexes into archetypes created by load
+    enum ComponentSet : uint8_t {
+        HAS_MESH = 1,
+        HAS_RENDERER = 2,
+        HAS_ROTATOR = 4,
+        HAS_RIGIDBODY = 8
+    };
+
+    const uint8_t COMPONENT_SETS = 16;
+
+    /// Archetype of objects with given components, columns are those GameObject::addComponent would create
+    uint32_t archetypeOf(World & world, const uint8_t & set) {
+        uint32_t archetype = world.archetypeWith<Transform>(0);
+
+        if (set & HAS_MESH) archetype = world.archetypeWith<std::shared_ptr<MeshComponent>>(archetype);
+        if (set & HAS_RENDERER) archetype = world.archetypeWith<std::shared_ptr<MeshRenderer>>(archetype);
+        if (set & HAS_ROTATOR) archetype = world.archetypeWith<std::shared_ptr<Rotator>>(archetype);
+        if (set & HAS_RIGIDBODY) archetype = world.archetypeWith<std::shared_ptr<Rigidbody>>(archetype);
+
+        if (set & (HAS_ROTATOR | HAS_RIGIDBODY)) archetype = world.archetypeWith<BehaviourTag>(archetype);
+
+        return archetype;
+    }
+
+    /// Texture paths must outlive renderers, which keep only a pointer
+    const char * internString(const std::string & text) {
+        static std::unordered_set<std::string> strings;
+        return strings.insert(text).first->c_str();
+    }
+}
+
+bool SceneFile::save(const Scene & scene, const std::string & path) {
+    PROFILE_FUNCTION();
+
+    SceneWriter writer;
+
+    for (auto & child : scene.children) {
+        writer.addObject(*child, NO_PARENT);
+    }
+
+    if (writer.unsupportedMeshes > 0) {
+        std::cout << "SceneFile: " << writer.unsupportedMeshes << " line or surface meshes saved without their parameters" << std::endl;
+    }
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.projection = static_cast<uint32_t>(scene.projection);
+
+    uint64_t offset = sizeof(Header);
+
+    header.transforms = placeSection(offset, writer.transforms);
+    header.parents = placeSection(offset, writer.parents);
+    header.meshes = placeSection(offset, writer.meshes);
+    header.renderers = placeSection(offset, writer.renderers);
+    header.rotators = placeSection(offset, writer.rotators);
+    header.rigidbodies = placeSection(offset, writer.rigidbodies);
+    header.strings = placeSection(offset, writer.strings);
+    header.paths = placeSection(offset, writer.paths);
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+
+    if (!stream) {
+        std::cerr << "SceneFile: cannot write " << path << std::endl;
+        return false;
+    }
+
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+
+    writeSection(stream, header.transforms, writer.transforms);
+    writeSection(stream, header.parents, writer.parents);
+    writeSection(stream, header.meshes, writer.meshes);
+    writeSection(stream, header.renderers, writer.renderers);
+    writeSection(stream, header.rotators, writer.rotators);
+    writeSection(stream, header.rigidbodies, writer.rigidbodies);
+    writeSection(stream, header.strings, writer.strings);
+    writeSection(stream, header.paths, writer.paths);
+
+    return static_cast<bool>(stream);
+}
+
+std::shared_ptr<Scene> SceneFile::load(const std::string & path) {
+    PROFILE_FUNCTION();
+
+    MappedFile file(path);
+
+    if (!file.isOpen() || file.getSize() < sizeof(Header)) {
+        std::cerr << "SceneFile: cannot open " << path << std::endl;
+        return nullptr;
+    }
+
+    const auto & header = *reinterpret_cast<const Header *>(file.getData());
+
+    if (header.magic != MAGIC || header.version != VERSION) {
+        std::cerr << "SceneFile: " << path << " is not a scene file of version " << VERSION << std::endl;
+        return nullptr;
+    }
+
+    uint64_t count = header.transforms.count;
+
+    auto * transforms = sectionData<TransformRecord>(file, header.transforms);
+    auto * parents = sectionData<int32_t>(file, header.parents);
+    auto * meshes = sectionData<MeshRecord>(file, header.meshes);
+    auto * renderers = sectionData<RendererRecord>(file, header.renderers);
+    auto * rotators = sectionData<RotatorRecord>(file, header.rotators);
+    auto * rigidbodies = sectionData<RigidbodyRecord>(file, header.rigidbodies);
+    auto * strings = sectionData<char>(file, header.strings);
+    auto * paths = sectionData<uint32_t>(file, header.paths);
+
+    bool valid = transforms && parents && meshes && renderers && rotators && rigidbodies && strings && paths &&
+                 header.parents.count == count && header.projection <= ORTOGRAPHIC &&
+                 (header.strings.count == 0 || strings[header.strings.count - 1] == '\0') &&
+                 validObjects(meshes, header.meshes.count, count) &&
+                 validObjects(renderers, header.renderers.count, count) &&
+                 validObjects(rotators, header.rotators.count, count) &&
+                 validObjects(rigidbodies, header.rigidbodies.count, count);
+
+    auto validString = [&header](const uint32_t & offset) {
+        return offset == NO_STRING || offset < header.strings.count;
+    };
+
+    /// Enums are cast from records, values outside of them are rejected
+    for (uint64_t i = 0; valid && i < header.meshes.count; i++) {
+        valid = validString(meshes[i].path) && meshes[i].meshType <= POINT;
+    }
+
+    for (uint64_t i = 0; valid && i < header.renderers.count; i++) {
+        auto & record = renderers[i];
+
+        valid = validString(record.texture) && record.shaderType <= MANDELBROT && record.projection <= ORTOGRAPHIC &&
+                record.firstPath <= header.paths.count && record.pathCount <= header.paths.count - record.firstPath;
+    }
+
+    for (uint64_t i = 0; valid && i < header.paths.count; i++) {
+        valid = paths[i] != NO_STRING && validString(paths[i]);
+    }
+
+    if (!valid) {
+        std::cerr << "SceneFile: " << path << " is malformed" << std::endl;
+        return nullptr;
+    }
+
+    auto scene = std::make_shared<Scene>();
+    scene->projection = static_cast<Projection>(header.projection);
+
+    GameObjectFactory::reserve(count);
+    reservePooled<Rotator>(header.rotators.count);
+    reservePooled<Rigidbody>(header.rigidbodies.count);
+
+    /// Every object is created directly in archetype of its component set, reserved for all its objects
+    std::vector<uint8_t> sets(count, 0);
+
+    for (uint64_t i = 0; i < header.meshes.count; i++) sets[meshes[i].object] |= HAS_MESH;
+    for (uint64_t i = 0; i < header.renderers.count; i++) sets[renderers[i].object] |= HAS_RENDERER;
+    for (uint64_t i = 0; i < header.rotators.count; i++) sets[rotators[i].object] |= HAS_ROTATOR;
+    for (uint64_t i = 0; i < header.rigidbodies.count; i++) sets[rigidbodies[i].object] |= HAS_RIGIDBODY;
+
+    size_t setCounts[COMPONENT_SETS] = {};
+
+    for (uint64_t i = 0; i < count; i++) {
+        setCounts[sets[i]]++;
+    }
+
+    auto & world = World::Instance();
+    uint32_t archetypes[COMPONENT_SETS];
+
+    world.reserve(count);
+
+    for (uint8_t set = 0; set < COMPONENT_SETS; set++) {
+        if (setCounts[set] == 0) continue;
+
+        archetypes[set] = archetypeOf(world, set);
+        world.reserve(archetypes[set], setCounts[set]);
+    }
+
+    std::vector<std::shared_ptr<GameObject>> objects(count);
+
+    uint64_t mesh = 0, renderer = 0, rotator = 0, rigidbody = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        auto object = makePooled<GameObject>(world.create(archetypes[sets[i]]));
+
+        auto & record = transforms[i];
+        auto & transform = object->transform();
+
+        transform.setPosition(glm::vec3(record.position[0], record.position[1], record.position[2]));
+        transform.setOrientation(glm::quat(record.orientation[3], record.orientation[0], record.orientation[1], record.orientation[2]));
+        transform.setScale(glm::vec3(record.scale[0], record.scale[1], record.scale[2]));
+        transform.setPivot(glm::vec3(record.pivot[0], record.pivot[1], record.pivot[2]));
+        transform.storePrevious();
+
+        if (mesh < header.meshes.count && meshes[mesh].object == i) {
+            auto & meshRecord = meshes[mesh++];
+
+            auto component = makePooled<MeshComponent>(static_cast<MeshType>(meshRecord.meshType));
+
+            if (meshRecord.path != NO_STRING) {
+                component->path = strings + meshRecord.path;
+            }
+
+            object->addComponent(component);
+        }
+
+        if (renderer < header.renderers.count && renderers[renderer].object == i) {
+            auto & rendererRecord = renderers[renderer++];
+
+            auto component = makePooled<MeshRenderer>();
+            component->shaderType = static_cast<ShaderType>(rendererRecord.shaderType);
+            component->projection = static_cast<Projection>(rendererRecord.projection);
+            component->renderingMode = rendererRecord.renderingMode;
+            component->instanced = rendererRecord.flags & INSTANCED;
+            component->enableBoundingBox = rendererRecord.flags & BOUNDING_BOX;
+            component->disableNormals = rendererRecord.flags & DISABLE_NORMALS;
+            component->frustumCulling = rendererRecord.flags & FRUSTUM_CULLING;
+            component->cubeMap = rendererRecord.flags & CUBE_MAP;
+            component->color = glm::vec4(rendererRecord.color[0], rendererRecord.color[1], rendererRecord.color[2], rendererRecord.color[3]);
+
+            if (rendererRecord.texture != NO_STRING) {
+                component->texture = internString(strings + rendererRecord.texture);
+            }
+
+            for (uint32_t p = 0; p < rendererRecord.pathCount; p++) {
+                component->paths.emplace_back(strings + paths[rendererRecord.firstPath + p]);
+            }
+
+            object->addComponent(component);
+        }
+
+        if (rotator < header.rotators.count && rotators[rotator].object == i) {
+            auto & rotatorRecord = rotators[rotator++];
+
+            auto component = makePooled<Rotator>();
+            component->speed = glm::vec3(rotatorRecord.speed[0], rotatorRecord.speed[1], rotatorRecord.speed[2]);
+
+            object->addComponent(component);
+        }
+
+        if (rigidbody < header.rigidbodies.count && rigidbodies[rigidbody].object == i) {
+            auto & rigidbodyRecord = rigidbodies[rigidbody++];
+
+            auto component = makePooled<Rigidbody>();
+            component->mass = rigidbodyRecord.mass;
+            component->restitution = rigidbodyRecord.restitution;
+
+            object->addComponent(component);
+        }
+
+        /// Parent precedes its children, anything else is treated as root
+        int32_t parent = parents[i];
+
+        if (parent >= 0 && static_cast<uint64_t>(parent) < i) {
+            objects[parent]->addChild(object);
+        }
+        else {
+            scene->addChild(object);
+        }
+
+        objects[i] = std::move(object);
+    }
+
+    return scene;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <Scene/Scene.h>
+
+/// Saves scenes into binary scene files and loads them back (see SceneFormat).
+///
+/// Loading maps the file and reads records in place - there is nothing to parse, objects are created
+/// straight from mapped arrays into pools reserved up front. Component set of every object is known from
+/// sections, so its entity is created directly in final archetype, with columns reserved once per archetype. Supported components: MeshComponent (type and path),
+/// MeshRenderer (including cube map paths), Rotator, Rigidbody. Other components are not stored.
+class SceneFile {
+
+    public:
+
+        /// Returns false when file cannot be written
+        static bool save(const Scene & scene, const std::string & path);
+
+        /// Returns nullptr when file is missing, has different version or is malformed
+        static std::shared_ptr<Scene> load(const std::string & path);
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/// Layout of binary scene files (.scene).
+///
+/// File is header followed by sections of fixed size records. Sections are addressed by byte offsets from start
+/// of file, so file can be mapped anywhere and records are read in place. Objects are stored in pre-order, parent
+/// always precedes its children. Per-object sections (transforms, parents) have one record per object, component
+/// sections are sparse and sorted by object index. Strings are zero terminated, referenced by offset into strings.
+/// Integers and floats are little endian, any change of layout increases VERSION.
+namespace SceneFormat {
+
+    static constexpr uint32_t MAGIC = 0x454E4353; // "SCNE"
+    static constexpr uint32_t VERSION = 2;
+
+    static constexpr uint32_t NO_STRING = UINT32_MAX;
+    static constexpr int32_t NO_PARENT = -1;
+
+    /// Sections start at multiples of this, so records are aligned in mapped memory
+    static constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+    struct Section {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t projection;
+        uint32_t reserved;
+
+        Section transforms;
+        Section parents;
+        Section meshes;
+        Section renderers;
+        Section rotators;
+        Section rigidbodies;
+        Section strings;
+        /// String offsets of renderer texture lists, see RendererRecord::firstPath
+        Section paths;
+    };
+
+    struct TransformRecord {
+        float position[3];
+        float orientation[4];   // x, y, z, w
+        float scale[3];
+        float pivot[3];
+    };
+
+    struct MeshRecord {
+        uint32_t object;
+        uint32_t meshType;
+        uint32_t path;
+    };
+
+    enum RendererFlags : uint32_t {
+        INSTANCED = 1u << 0u,
+        BOUNDING_BOX = 1u << 1u,
+        DISABLE_NORMALS = 1u << 2u,
+        FRUSTUM_CULLING = 1u << 3u,
+        CUBE_MAP = 1u << 4u
+    };
+
+    struct RendererRecord {
+        uint32_t object;
+        uint32_t shaderType;
+        uint32_t projection;
+        uint32_t renderingMode;
+        uint32_t flags;
+        uint32_t texture;
+        /// Texture list (cube map faces) is pathCount entries of paths section starting at firstPath
+        uint32_t firstPath;
+        uint32_t pathCount;
+        float color[4];
+    };
+
+    struct RotatorRecord {
+        uint32_t object;
+        float speed[3];
+    };
+
+    struct RigidbodyRecord {
+        uint32_t object;
+        float mass;
+        float restitution;
+    };
+
+    static_assert(sizeof(Header) == 16 + 8 * sizeof(Section), "Header must not contain padding");
+    static_assert(sizeof(TransformRecord) == 13 * 4, "TransformRecord must not contain padding");
+    static_assert(sizeof(RendererRecord) == 12 * 4, "RendererRecord must not contain padding");
+    static_assert(std::is_trivially_copyable<RendererRecord>::value, "Records are read in place");
+}
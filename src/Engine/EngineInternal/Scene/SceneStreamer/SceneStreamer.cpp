@@ -0,0 +1,190 @@
+#include "SceneStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <Memory/ObjectPool/ObjectPool.h>
+#include <Profiling/Profile.h>
+#include <Rendering/Mesh/MeshBuilder.h>
+#include <Scene/CommandBuffer/CommandBuffer.h>
+#include <Utils/NormalsGenerator/NormalsGenerator.h>
+
+SceneStreamer::SceneStreamer(const float & cellSize, const float & loadRadius, const float & unloadRadius,
+                             CellGenerator generator) :
+        cellSize(cellSize),
+        loadRadius(loadRadius),
+        unloadRadius(std::max(unloadRadius, loadRadius + cellSize)),
+        generator(std::move(generator)),
+        meshCache(std::make_shared<MeshCache>()) {}
+
+SceneStreamer::~SceneStreamer() {
+    JobSystem::Instance().wait(loading);
+}
+
+float SceneStreamer::distanceTo(const CellCoord & coord, const glm::vec3 & viewer) const {
+    float minX = static_cast<float>(coord.x) * cellSize;
+    float minZ = static_cast<float>(coord.z) * cellSize;
+
+    float dx = std::max(std::max(minX - viewer.x, viewer.x - (minX + cellSize)), 0.0f);
+    float dz = std::max(std::max(minZ - viewer.z, viewer.z - (minZ + cellSize)), 0.0f);
+
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+void SceneStreamer::update(const glm::vec3 & viewer) {
+    PROFILE_FUNCTION();
+
+    CommandBuffer commands;
+
+    /// Unload far cells. Jobs of cells still loading finish on their own, results are dropped.
+    for (auto it = cells.begin(); it != cells.end();) {
+        if (distanceTo(it->first, viewer) > unloadRadius) {
+            for (auto & object : it->second.objects) {
+                commands.destroy(object);
+            }
+
+            objectCount -= it->second.objects.size();
+            it = cells.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    /// Start loading missing cells in range, nearest first
+    auto reach = static_cast<int32_t>(std::ceil(loadRadius / cellSize));
+    auto viewerX = static_cast<int32_t>(std::floor(viewer.x / cellSize));
+    auto viewerZ = static_cast<int32_t>(std::floor(viewer.z / cellSize));
+
+    std::vector<std::pair<float, CellCoord>> missing;
+
+    for (int32_t x = viewerX - reach; x <= viewerX + reach; x++) {
+        for (int32_t z = viewerZ - reach; z <= viewerZ + reach; z++) {
+            CellCoord coord { x, z };
+            float distance = distanceTo(coord, viewer);
+
+            if (distance <= loadRadius && cells.count(coord) == 0) {
+                missing.emplace_back(distance, coord);
+            }
+        }
+    }
+
+    std::sort(missing.begin(), missing.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+
+    for (auto & [distance, coord] : missing) {
+        if (static_cast<size_t>(loading.value.load(std::memory_order_acquire)) >= maxLoadsInFlight) break;
+
+        startLoad(coord, cells[coord]);
+    }
+
+    /// Instantiate generated cells within budget, nearest first
+    std::vector<std::pair<float, Cell *>> ready;
+
+    for (auto & [coord, cell] : cells) {
+        if (cell.load.get() && cell.load->done.load(std::memory_order_acquire)) {
+            ready.emplace_back(distanceTo(coord, viewer), &cell);
+        }
+    }
+
+    std::sort(ready.begin(), ready.end(), [](const auto & a, const auto & b) { return a.first < b.first; });
+
+    size_t budget = spawnBudget;
+
+    for (auto & [distance, cell] : ready) {
+        auto & generated = cell->load->objects;
+
+        while (budget > 0 && cell->objects.size() < generated.size()) {
+            auto & description = generated[cell->objects.size()];
+
+            auto object = makePooled<GameObject>(description.position, description.rotation, description.scale);
+
+            if (description.mesh.get()) object->addComponent(description.mesh);
+            if (description.renderer.get()) object->addComponent(description.renderer);
+            if (description.setup) description.setup(*object);
+
+            commands.spawn(object);
+            cell->objects.push_back(object);
+            budget--;
+        }
+
+        /// Descriptions are not needed once everything is spawned
+        if (cell->objects.size() == generated.size()) {
+            objectCount += generated.size();
+            cell->load.reset();
+        }
+        else {
+            break;
+        }
+    }
+
+    commands.submit();
+}
+
+void SceneStreamer::startLoad(const CellCoord & coord, Cell & cell) {
+    auto load = std::make_shared<CellLoad>();
+    cell.load = load;
+
+    auto cache = meshCache;
+    auto generate = generator;
+
+    auto job = [load, cache, generate, coord]() {
+        PROFILE_SCOPE("SceneStreamer::loadCell");
+
+        load->objects = generate(coord);
+        loadAssets(load->objects, *cache);
+        load->done.store(true, std::memory_order_release);
+    };
+
+    auto & jobs = JobSystem::Instance();
+
+    /// Nobody would pick the job up until main thread waits for something
+    if (jobs.getWorkerCount() == 0) {
+        job();
+        return;
+    }
+
+    jobs.run(job, &loading);
+}
+
+void SceneStreamer::loadAssets(std::vector<CellObject> & objects, MeshCache & cache) {
+    for (auto & object : objects) {
+        if (!object.mesh.get() || object.mesh->mesh.get()) continue;
+
+        bool shared = object.renderer.get() && object.renderer->instanced;
+        std::string id = object.mesh->getMeshIdText();
+
+        if (shared) {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+
+            auto found = cache.meshes.find(id);
+
+            if (found != cache.meshes.end()) {
+                object.mesh->mesh = found->second.lock();
+                if (object.mesh->mesh.get()) continue;
+            }
+        }
+
+        auto mesh = MeshBuilder::buildMesh(object.mesh);
+
+        if (object.renderer.get() && !object.renderer->disableNormals && mesh->getNormals().empty()) {
+            NormalsGenerator::generate(mesh.get());
+        }
+
+        object.mesh->mesh = mesh;
+
+        /// Mesh decoded by two cells at the same time - first one is kept
+        if (shared) {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+
+            auto & cached = cache.meshes[id];
+            auto existing = cached.lock();
+
+            if (existing.get()) {
+                object.mesh->mesh = existing;
+            }
+            else {
+                cached = mesh;
+            }
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Scene/GameObject/GameObject.h>
+#include <Components/MeshComponent/MeshComponent.h>
+#include <Rendering/Mesh/MeshRenderer/MeshRenderer.h>
+
+/// Cell of streamed world on XZ plane, covers [x, x + 1) * cellSize by [z, z + 1) * cellSize
+struct CellCoord {
+    int32_t x = 0;
+    int32_t z = 0;
+
+    bool operator==(const CellCoord & other) const { return x == other.x && z == other.z; }
+};
+
+struct CellCoordHash {
+    size_t operator()(const CellCoord & coord) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) |
+                                     static_cast<uint32_t>(coord.z));
+    }
+};
+
+/// Object placed in streamed cell. Described on worker thread - components are not attached to anything yet,
+/// game object itself is created on main thread.
+struct CellObject {
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 rotation = glm::vec3(0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    std::shared_ptr<MeshComponent> mesh;
+    std::shared_ptr<MeshRenderer> renderer;
+
+    /// Adds remaining components (behaviours), runs on main thread
+    std::function<void(GameObject &)> setup;
+};
+
+/// Loads and unloads cells of a world around the viewer.
+///
+/// Cells closer than load radius are generated on worker threads together with their meshes (file I/O, decoding,
+/// normals), nearest first. Generated cells are instantiated on main thread, at most spawnBudget objects per frame,
+/// and spawned through CommandBuffer, so their GL buffers are created by the same batch. Cells are unloaded only
+/// beyond unload radius, distance between the two radii keeps cells at the border from reloading every frame.
+class SceneStreamer {
+
+    public:
+
+        /// Objects of one cell, called on worker threads - must not touch scene or GL
+        typedef std::function<std::vector<CellObject>(const CellCoord &)> CellGenerator;
+
+    private:
+
+        struct CellLoad {
+            std::atomic<bool> done { false };
+            std::vector<CellObject> objects;
+        };
+
+        struct Cell {
+            std::shared_ptr<CellLoad> load;
+
+            /// Objects spawned so far, cell is fully loaded when all generated objects are spawned
+            std::vector<std::shared_ptr<GameObject>> objects;
+        };
+
+        /// Meshes of instanced renderers shared by all cells, so every model is decoded once while it is in use
+        struct MeshCache {
+            std::mutex mutex;
+            std::unordered_map<std::string, std::weak_ptr<Mesh>> meshes;
+        };
+
+        float cellSize;
+        float loadRadius;
+        float unloadRadius;
+
+        CellGenerator generator;
+
+        std::unordered_map<CellCoord, Cell, CellCoordHash> cells;
+
+        std::shared_ptr<MeshCache> meshCache;
+
+        /// Loading jobs, including ones of cells unloaded before they finished
+        JobCounter loading;
+
+        size_t maxLoadsInFlight = 2;
+        size_t spawnBudget = 2000;
+
+        size_t objectCount = 0;
+
+        float distanceTo(const CellCoord & coord, const glm::vec3 & viewer) const;
+
+        void startLoad(const CellCoord & coord, Cell & cell);
+
+        /// Builds meshes of generated objects, worker thread
+        static void loadAssets(std::vector<CellObject> & objects, MeshCache & cache);
+
+    public:
+
+        /// unloadRadius is raised to loadRadius + cellSize when smaller
+        SceneStreamer(const float & cellSize, const float & loadRadius, const float & unloadRadius, CellGenerator generator);
+
+        SceneStreamer(const SceneStreamer & other) = delete;
+
+        SceneStreamer & operator=(const SceneStreamer & other) = delete;
+
+        /// Waits for loading jobs, spawned objects stay in the scene
+        ~SceneStreamer();
+
+        /// Main thread, between frames (before EngineRenderer::applyCommands)
+        void update(const glm::vec3 & viewer);
+
+        void setMaxLoadsInFlight(const size_t & count) { maxLoadsInFlight = std::max<size_t>(1, count); }
+
+        void setSpawnBudget(const size_t & count) { spawnBudget = std::max<size_t>(1, count); }
+
+        /// Cells loaded or being loaded
+        size_t getCellCount() const { return cells.size(); }
+
+        size_t getObjectCount() const { return objectCount; }
+};
@@ -0,0 +1,124 @@
+#include "Transform.h"
+
+#include <cmath>
+
+Transform::Transform() {
+    slot = storage().allocate();
+}
+
+Transform::Transform(const Transform & other) : Transform() {
+    *this = other;
+}
+
+Transform & Transform::operator=(const Transform & other) {
+    if (this == &other) return *this;
+
+    setPosition(other.getPosition());
+    setOrientation(other.getOrientation());
+    setScale(other.getScale());
+    setPivot(other.getPivot());
+    setAngularVelocity(other.getAngularVelocity());
+    setPrevious(other.getPreviousPosition(), other.getPreviousOrientation(), other.getPreviousScale());
+
+    return *this;
+}
+
+Transform::Transform(Transform && other) noexcept : slot(other.slot), owner(other.owner) {
+    other.slot = NO_SLOT;
+}
+
+Transform & Transform::operator=(Transform && other) noexcept {
+    if (this == &other) return *this;
+
+    /// Slot of view belongs to other transform
+    if (!owner) {
+        return *this = static_cast<const Transform &>(other);
+    }
+
+    if (slot != NO_SLOT) {
+        storage().release(slot);
+    }
+
+    slot = other.slot;
+    owner = other.owner;
+    other.slot = NO_SLOT;
+
+    return *this;
+}
+
+Transform::~Transform() {
+    if (owner && slot != NO_SLOT) {
+        storage().release(slot);
+    }
+}
+
+Transform Transform::view(const Transform & transform) {
+    return Transform(transform.slot);
+}
+
+glm::vec3 Transform::getRotation() const {
+    glm::quat q = getOrientation();
+
+    float sinPitch = 2.0f * (q.w * q.y - q.z * q.x);
+    sinPitch = sinPitch > 1.0f ? 1.0f : (sinPitch < -1.0f ? -1.0f : sinPitch);
+
+    return glm::vec3(
+            std::atan2(2.0f * (q.w * q.x + q.y * q.z), 1.0f - 2.0f * (q.x * q.x + q.y * q.y)),
+            std::asin(sinPitch),
+            std::atan2(2.0f * (q.w * q.z + q.x * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z))
+    );
+}
+
+void Transform::setRotation(const glm::vec3 & rotation) {
+    float cx = std::cos(rotation.x * 0.5f), sx = std::sin(rotation.x * 0.5f);
+    float cy = std::cos(rotation.y * 0.5f), sy = std::sin(rotation.y * 0.5f);
+    float cz = std::cos(rotation.z * 0.5f), sz = std::sin(rotation.z * 0.5f);
+
+    setOrientation(glm::quat(
+            cx * cy * cz + sx * sy * sz,
+            sx * cy * cz - cx * sy * sz,
+            cx * sy * cz + sx * cy * sz,
+            cx * cy * sz - sx * sy * cz
+    ));
+}
+
+void Transform::setAngularVelocity(const glm::vec3 & velocity) {
+    auto & s = storage();
+
+    s.angularVelocityX[slot] = velocity.x;
+    s.angularVelocityY[slot] = velocity.y;
+    s.angularVelocityZ[slot] = velocity.z;
+
+    if (velocity == glm::vec3(0.0f)) {
+        s.flags[slot] &= ~TransformStorage::SPINNING;
+    }
+    else {
+        s.flags[slot] |= TransformStorage::SPINNING;
+    }
+}
+
+void Transform::setPrevious(const glm::vec3 & position, const glm::quat & orientation, const glm::vec3 & scale) {
+    auto & s = storage();
+
+    s.previousPositionX[slot] = position.x;
+    s.previousPositionY[slot] = position.y;
+    s.previousPositionZ[slot] = position.z;
+
+    s.previousRotationX[slot] = orientation.x;
+    s.previousRotationY[slot] = orientation.y;
+    s.previousRotationZ[slot] = orientation.z;
+    s.previousRotationW[slot] = orientation.w;
+
+    s.previousScaleX[slot] = scale.x;
+    s.previousScaleY[slot] = scale.y;
+    s.previousScaleZ[slot] = scale.z;
+
+    markChanged();
+}
+
+void Transform::storePrevious() {
+    setPrevious(getPosition(), getOrientation(), getScale());
+
+    /// Both states are equal now, matrix does not depend on alpha
+    storage().flags[slot] &= ~TransformStorage::CHANGED;
+}
@@ -1,34 +1,192 @@
 #pragma once
 
 #include "Engine/EngineInternal/Utils/MatrixUtils.h"
+#include <Engine/EngineInternal/Scene/TransformStorage/TransformStorage.h>
 #include <vector>
 #include <iomanip>
 
+/// Handle to one slot of TransformStorage.
+///
+/// State is not stored in the object itself - setters write into storage arrays and mark the slot,
+/// world matrices of all transforms are computed together by TransformStorage::computeMatrices.
+/// Orientation is kept as quaternion, euler angles are converted in Z * Y * X order (MatrixUtils::rotationMatrix).
+/// Position, orientation and scale are relative to parent transform when there is one.
 class Transform {
 
+    private:
+
+        /// Slot of moved-from transform
+        static const uint32_t NO_SLOT = UINT32_MAX;
+
+        uint32_t slot;
+
+        /// View shares slot of another transform and never releases it
+        bool owner = true;
+
+        static TransformStorage & storage() { return TransformStorage::Instance(); }
+
+        /// View of slot, see view()
+        explicit Transform(const uint32_t & viewedSlot) : slot(viewedSlot), owner(false) {}
+
+        void markChanged() { storage().flags[slot] |= TransformStorage::DIRTY | TransformStorage::CHANGED; }
+
     public:
-        bool dirty = true;
 
-        glm::vec3 position = glm::vec3(0.0f);
-        glm::vec3 rotation = glm::vec3(0.0f);
-        glm::vec3 scale = glm::vec3(1.0f);
-        glm::vec3 pivot = glm::vec3(0.0f);
+        Transform();
+
+        /// Copies state into newly allocated slot
+        Transform(const Transform & other);
+
+        /// Copies state, matrix target is kept
+        Transform & operator=(const Transform & other);
+
+        /// Takes slot of other transform, so World can move transforms between archetype columns
+        Transform(Transform && other) noexcept;
+
+        /// Releases own slot and takes slot of other transform
+        Transform & operator=(Transform && other) noexcept;
+
+        ~Transform();
+
+        /// Non owning handle to slot of transform, valid as long as that transform keeps its slot.
+        /// Writes through view change the viewed transform, assigning to view copies state.
+        static Transform view(const Transform & transform);
+
+        uint32_t getSlot() const { return slot; }
 
-        glm::mat4x4 rotationMatrix;
-        glm::mat4x4 scaleMatrix;
-        glm::mat4x4 positionMatrix;
-        glm::mat4x4 modelMatrix;
-        glm::mat4x4 pivotMat;
+        /// Local state becomes relative to parent, nullptr detaches. Fails when parent is this transform's descendant.
+        bool setParent(const Transform * parent) {
+            return storage().setParent(slot, parent ? static_cast<int32_t>(parent->slot) : -1);
+        }
+
+        bool hasParent() const { return storage().getParent(slot) >= 0; }
+
+        glm::vec3 getPosition() const {
+            auto & s = storage();
+            return glm::vec3(s.positionX[slot], s.positionY[slot], s.positionZ[slot]);
+        }
+
+        void setPosition(const glm::vec3 & position) {
+            auto & s = storage();
+            s.positionX[slot] = position.x;
+            s.positionY[slot] = position.y;
+            s.positionZ[slot] = position.z;
+            markChanged();
+        }
+
+        glm::vec3 getScale() const {
+            auto & s = storage();
+            return glm::vec3(s.scaleX[slot], s.scaleY[slot], s.scaleZ[slot]);
+        }
+
+        void setScale(const glm::vec3 & scale) {
+            auto & s = storage();
+            s.scaleX[slot] = scale.x;
+            s.scaleY[slot] = scale.y;
+            s.scaleZ[slot] = scale.z;
+            markChanged();
+        }
+
+        glm::vec3 getPivot() const {
+            auto & s = storage();
+            return glm::vec3(s.pivotX[slot], s.pivotY[slot], s.pivotZ[slot]);
+        }
+
+        void setPivot(const glm::vec3 & pivot) {
+            auto & s = storage();
+            s.pivotX[slot] = pivot.x;
+            s.pivotY[slot] = pivot.y;
+            s.pivotZ[slot] = pivot.z;
+            markChanged();
+        }
+
+        glm::quat getOrientation() const {
+            auto & s = storage();
+            return glm::quat(s.rotationW[slot], s.rotationX[slot], s.rotationY[slot], s.rotationZ[slot]);
+        }
+
+        void setOrientation(const glm::quat & orientation) {
+            auto & s = storage();
+            s.rotationX[slot] = orientation.x;
+            s.rotationY[slot] = orientation.y;
+            s.rotationZ[slot] = orientation.z;
+            s.rotationW[slot] = orientation.w;
+            markChanged();
+        }
+
+        /// Euler angles in radians
+        glm::vec3 getRotation() const;
+
+        void setRotation(const glm::vec3 & rotation);
+
+        glm::vec3 getAngularVelocity() const {
+            auto & s = storage();
+            return glm::vec3(s.angularVelocityX[slot], s.angularVelocityY[slot], s.angularVelocityZ[slot]);
+        }
+
+        /// Euler angle rates in radians per second, applied by storage once per simulation tick
+        void setAngularVelocity(const glm::vec3 & velocity);
+
+        glm::vec3 getPreviousPosition() const {
+            auto & s = storage();
+            return glm::vec3(s.previousPositionX[slot], s.previousPositionY[slot], s.previousPositionZ[slot]);
+        }
+
+        glm::quat getPreviousOrientation() const {
+            auto & s = storage();
+            return glm::quat(s.previousRotationW[slot], s.previousRotationX[slot], s.previousRotationY[slot], s.previousRotationZ[slot]);
+        }
+
+        glm::vec3 getPreviousScale() const {
+            auto & s = storage();
+            return glm::vec3(s.previousScaleX[slot], s.previousScaleY[slot], s.previousScaleZ[slot]);
+        }
+
+        /// Overrides state from previous simulation tick
+        void setPrevious(const glm::vec3 & position, const glm::quat & orientation, const glm::vec3 & scale);
+
+        /// Copies current state to previous state of this transform only
+        void storePrevious();
+
+        /// True when state changed during last tick, so rendered matrix depends on interpolation alpha
+        bool isInterpolating() const { return storage().flags[slot] & TransformStorage::CHANGED; }
+
+        /// True until matrix is computed after last change
+        bool isDirty() const { return storage().flags[slot] & TransformStorage::DIRTY; }
+
+        /// True when current or previous orientation is not identity
+        bool isRotated() const {
+            auto & s = storage();
+            return s.rotationW[slot] != 1.0f || s.previousRotationW[slot] != 1.0f;
+        }
+
+        glm::vec3 interpolatedPosition(const float & alpha) const {
+            return glm::mix(getPreviousPosition(), getPosition(), alpha);
+        }
+
+        glm::vec3 interpolatedScale(const float & alpha) const {
+            return glm::mix(getPreviousScale(), getScale(), alpha);
+        }
+
+        /// Instance matrix this transform writes into when it is visible
+        void setMatrixTarget(std::vector<glm::mat4x4> * matrices, const int & index) {
+            auto & target = storage().targets[slot];
+            target.matrices = matrices;
+            target.index = index;
+            markChanged();
+        }
 
-        int modelMatrixIndex = 0;
+        int getMatrixIndex() const { return storage().targets[slot].index; }
 
-        std::vector<glm::mat4x4> * matricesRef;
+        /// Matrix is computed in next TransformStorage::computeMatrices
+        void markVisible() { storage().markVisible(slot); }
 
-        void calculateModelMatrix() {
-            (*matricesRef)[modelMatrixIndex] = MatrixUtils::modelMatrix(scale, position, MatrixUtils::rotationMatrix(rotation));
+        /// Matrix relative to parent
+        glm::mat4x4 calculateModelMatrix(const float & alpha) const {
+            return storage().calculateMatrix(slot, alpha);
         }
 
-        void calculateModelMatrix2() {
-            (*matricesRef)[modelMatrixIndex] = positionMatrix * rotationMatrix * pivotMat * scaleMatrix;
+        glm::mat4x4 calculateWorldMatrix(const float & alpha) const {
+            return storage().calculateWorldMatrix(slot, alpha);
         }
-};
\ No newline at end of file
+};
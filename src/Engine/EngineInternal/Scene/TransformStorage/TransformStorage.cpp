@@ -0,0 +1,532 @@
+#include "TransformStorage.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+
+#include <FastMath.h>
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__linux__) && defined(__x86_64__)
+    /// Batched kernels are plain loops over arrays - let compiler vectorize them for every instruction set
+    #define TRANSFORM_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+    #define TRANSFORM_KERNEL
+#endif
+
+namespace {
+
+    /// Transforms processed together by batched kernels
+    const size_t BLOCK = 16;
+
+    struct TransformStreams {
+        const float * px;
+        const float * py;
+        const float * pz;
+        const float * ppx;
+        const float * ppy;
+        const float * ppz;
+
+        const float * qx;
+        const float * qy;
+        const float * qz;
+        const float * qw;
+        const float * pqx;
+        const float * pqy;
+        const float * pqz;
+        const float * pqw;
+
+        const float * sx;
+        const float * sy;
+        const float * sz;
+        const float * psx;
+        const float * psy;
+        const float * psz;
+
+        const float * vx;
+        const float * vy;
+        const float * vz;
+    };
+
+    /// Writes column major matrix of transform i into m[0], m[stride], ... m[15 * stride]
+    inline void composeMatrix(const TransformStreams & s, const size_t & i, const float & alpha, float * m, const size_t & stride) {
+        float x = s.ppx[i] + (s.px[i] - s.ppx[i]) * alpha;
+        float y = s.ppy[i] + (s.py[i] - s.ppy[i]) * alpha;
+        float z = s.ppz[i] + (s.pz[i] - s.ppz[i]) * alpha;
+
+        float scaleX = s.psx[i] + (s.sx[i] - s.psx[i]) * alpha;
+        float scaleY = s.psy[i] + (s.sy[i] - s.psy[i]) * alpha;
+        float scaleZ = s.psz[i] + (s.sz[i] - s.psz[i]) * alpha;
+
+        /// Normalized lerp along shorter arc
+        float dot = s.pqx[i] * s.qx[i] + s.pqy[i] * s.qy[i] + s.pqz[i] * s.qz[i] + s.pqw[i] * s.qw[i];
+        float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+        float qx = s.pqx[i] + (s.qx[i] * sign - s.pqx[i]) * alpha;
+        float qy = s.pqy[i] + (s.qy[i] * sign - s.pqy[i]) * alpha;
+        float qz = s.pqz[i] + (s.qz[i] * sign - s.pqz[i]) * alpha;
+        float qw = s.pqw[i] + (s.qw[i] * sign - s.pqw[i]) * alpha;
+
+        float inverseLength = FastMath::inverseSqrt(qx * qx + qy * qy + qz * qz + qw * qw);
+
+        qx *= inverseLength;
+        qy *= inverseLength;
+        qz *= inverseLength;
+        qw *= inverseLength;
+
+        float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+        float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+        float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+        float r00 = 1.0f - 2.0f * (yy + zz), r01 = 2.0f * (xy + wz), r02 = 2.0f * (xz - wy);
+        float r10 = 2.0f * (xy - wz), r11 = 1.0f - 2.0f * (xx + zz), r12 = 2.0f * (yz + wx);
+        float r20 = 2.0f * (xz + wy), r21 = 2.0f * (yz - wx), r22 = 1.0f - 2.0f * (xx + yy);
+
+        m[0 * stride] = r00 * scaleX;
+        m[1 * stride] = r01 * scaleX;
+        m[2 * stride] = r02 * scaleX;
+        m[3 * stride] = 0.0f;
+
+        m[4 * stride] = r10 * scaleY;
+        m[5 * stride] = r11 * scaleY;
+        m[6 * stride] = r12 * scaleY;
+        m[7 * stride] = 0.0f;
+
+        m[8 * stride] = r20 * scaleZ;
+        m[9 * stride] = r21 * scaleZ;
+        m[10 * stride] = r22 * scaleZ;
+        m[11 * stride] = 0.0f;
+
+        /// Pivot is rotated with the object
+        m[12 * stride] = x + r00 * s.vx[i] + r10 * s.vy[i] + r20 * s.vz[i];
+        m[13 * stride] = y + r01 * s.vx[i] + r11 * s.vy[i] + r21 * s.vz[i];
+        m[14 * stride] = z + r02 * s.vx[i] + r12 * s.vy[i] + r22 * s.vz[i];
+        m[15 * stride] = 1.0f;
+    }
+
+    /// Arguments by value and restrict output - otherwise stores to the block could alias them
+    /// and compiler reloads them or gives up on vectorization
+    TRANSFORM_KERNEL
+    void composeBlock(const TransformStreams & s, size_t base, size_t count, float alpha, float * __restrict out) {
+        for (size_t lane = 0; lane < count; lane++) {
+            composeMatrix(s, base + lane, alpha, out + lane, BLOCK);
+        }
+    }
+
+    TRANSFORM_KERNEL
+    void integrateRange(float * __restrict qx, float * __restrict qy, float * __restrict qz, float * __restrict qw,
+                        const float * __restrict vx, const float * __restrict vy, const float * __restrict vz,
+                        uint8_t * __restrict flags, size_t begin, size_t end, float deltaTime) {
+        const uint8_t spinning = TransformStorage::SPINNING | TransformStorage::ALIVE;
+        const uint8_t changed = TransformStorage::CHANGED | TransformStorage::DIRTY;
+
+        for (size_t i = begin; i < end; i++) {
+            uint8_t flag = flags[i];
+
+            /// Selects are written as arithmetic, otherwise compiler branches around the whole body.
+            /// Other transforms get zero step, identity rotation and unit length, so they stay bit exact.
+            int active = (flag & spinning) == spinning;
+            float weight = static_cast<float>(active);
+            float step = deltaTime * 0.5f * weight;
+
+            float sx, cx, sy, cy, sz, cz;
+
+            FastMath::sinCos(vx[i] * step, sx, cx);
+            FastMath::sinCos(vy[i] * step, sy, cy);
+            FastMath::sinCos(vz[i] * step, sz, cz);
+
+            /// Step rotation from euler angles, same order as MatrixUtils::rotationMatrix (Z * Y * X)
+            float dw = cx * cy * cz + sx * sy * sz;
+            float dx = sx * cy * cz - cx * sy * sz;
+            float dy = cx * sy * cz + sx * cy * sz;
+            float dz = cx * cy * sz - sx * sy * cz;
+
+            float w = qw[i] * dw - qx[i] * dx - qy[i] * dy - qz[i] * dz;
+            float x = qw[i] * dx + qx[i] * dw + qy[i] * dz - qz[i] * dy;
+            float y = qw[i] * dy - qx[i] * dz + qy[i] * dw + qz[i] * dx;
+            float z = qw[i] * dz + qx[i] * dy - qy[i] * dx + qz[i] * dw;
+
+            float inverseLength = FastMath::inverseSqrt(x * x + y * y + z * z + w * w);
+            inverseLength = inverseLength * weight + (1.0f - weight);
+
+            qx[i] = x * inverseLength;
+            qy[i] = y * inverseLength;
+            qz[i] = z * inverseLength;
+            qw[i] = w * inverseLength;
+
+            flags[i] = flag | static_cast<uint8_t>(active * changed);
+        }
+    }
+}
+
+void TransformStorage::reserve(const size_t & count) {
+    size_t size = flags.size() + (count > freeSlots.size() ? count - freeSlots.size() : 0);
+
+    for (auto * array : { &positionX, &positionY, &positionZ, &previousPositionX, &previousPositionY, &previousPositionZ,
+                          &rotationX, &rotationY, &rotationZ, &previousRotationX, &previousRotationY, &previousRotationZ,
+                          &scaleX, &scaleY, &scaleZ, &previousScaleX, &previousScaleY, &previousScaleZ,
+                          &pivotX, &pivotY, &pivotZ, &angularVelocityX, &angularVelocityY, &angularVelocityZ,
+                          &rotationW, &previousRotationW }) {
+        array->reserve(size);
+    }
+
+    flags.reserve(size);
+    targets.reserve(size);
+    parents.reserve(size);
+    childCounts.reserve(size);
+}
+
+uint32_t TransformStorage::allocate() {
+    uint32_t slot;
+
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(flags.size());
+
+        for (auto * array : { &positionX, &positionY, &positionZ, &previousPositionX, &previousPositionY, &previousPositionZ,
+                              &rotationX, &rotationY, &rotationZ, &previousRotationX, &previousRotationY, &previousRotationZ,
+                              &scaleX, &scaleY, &scaleZ, &previousScaleX, &previousScaleY, &previousScaleZ,
+                              &pivotX, &pivotY, &pivotZ, &angularVelocityX, &angularVelocityY, &angularVelocityZ,
+                              &rotationW, &previousRotationW }) {
+            array->push_back(0.0f);
+        }
+
+        flags.push_back(0);
+        targets.emplace_back();
+        parents.push_back(-1);
+        childCounts.push_back(0);
+    }
+
+    positionX[slot] = positionY[slot] = positionZ[slot] = 0.0f;
+    previousPositionX[slot] = previousPositionY[slot] = previousPositionZ[slot] = 0.0f;
+
+    rotationX[slot] = rotationY[slot] = rotationZ[slot] = 0.0f;
+    rotationW[slot] = 1.0f;
+    previousRotationX[slot] = previousRotationY[slot] = previousRotationZ[slot] = 0.0f;
+    previousRotationW[slot] = 1.0f;
+
+    scaleX[slot] = scaleY[slot] = scaleZ[slot] = 1.0f;
+    previousScaleX[slot] = previousScaleY[slot] = previousScaleZ[slot] = 1.0f;
+
+    pivotX[slot] = pivotY[slot] = pivotZ[slot] = 0.0f;
+    angularVelocityX[slot] = angularVelocityY[slot] = angularVelocityZ[slot] = 0.0f;
+
+    flags[slot] = ALIVE | DIRTY;
+    targets[slot] = MatrixTarget();
+    parents[slot] = -1;
+    childCounts[slot] = 0;
+
+    return slot;
+}
+
+void TransformStorage::release(const uint32_t & slot) {
+    setParent(slot, -1);
+
+    for (uint32_t child = 0; childCounts[slot] > 0 && child < parents.size(); child++) {
+        if (parents[child] == static_cast<int32_t>(slot)) {
+            setParent(child, -1);
+        }
+    }
+
+    flags[slot] = 0;
+    targets[slot] = MatrixTarget();
+    freeSlots.push_back(slot);
+}
+
+bool TransformStorage::setParent(const uint32_t & slot, const int32_t & parent) {
+    for (int32_t ancestor = parent; ancestor >= 0; ancestor = parents[ancestor]) {
+        if (ancestor == static_cast<int32_t>(slot)) {
+            std::cerr << "Transform can't be attached to itself or to its descendant" << std::endl;
+            return false;
+        }
+    }
+
+    int32_t previous = parents[slot];
+
+    if (previous == parent) return true;
+
+    if (previous >= 0 && --childCounts[previous] == 0) {
+        flags[previous] &= ~HAS_CHILDREN;
+    }
+
+    parents[slot] = parent;
+
+    if (parent >= 0) {
+        childCounts[parent]++;
+        flags[parent] |= HAS_CHILDREN;
+        flags[slot] |= PARENTED;
+    }
+    else {
+        flags[slot] &= ~PARENTED;
+    }
+
+    flags[slot] |= DIRTY;
+    hierarchyChanged = true;
+
+    return true;
+}
+
+void TransformStorage::rebuildHierarchy() {
+    PROFILE_FUNCTION();
+
+    std::vector<std::pair<uint32_t, uint32_t>> depthSlots;
+
+    for (uint32_t slot = 0; slot < flags.size(); slot++) {
+        if (!(flags[slot] & ALIVE) || !(flags[slot] & (PARENTED | HAS_CHILDREN))) continue;
+
+        uint32_t depth = 0;
+
+        for (int32_t ancestor = parents[slot]; ancestor >= 0; ancestor = parents[ancestor]) {
+            depth++;
+        }
+
+        depthSlots.emplace_back(depth, slot);
+    }
+
+    /// Slot order inside of level keeps memory access close to storage order
+    std::sort(depthSlots.begin(), depthSlots.end());
+
+    nodeSlots.resize(depthSlots.size());
+    nodeParents.resize(depthSlots.size());
+    nodeWorld.resize(depthSlots.size());
+    nodeIndexes.assign(flags.size(), -1);
+    levelStarts.clear();
+
+    for (size_t i = 0; i < depthSlots.size(); i++) {
+        uint32_t slot = depthSlots[i].second;
+
+        if (levelStarts.size() <= depthSlots[i].first) {
+            levelStarts.push_back(i);
+        }
+
+        nodeSlots[i] = slot;
+        nodeIndexes[slot] = static_cast<int32_t>(i);
+        nodeParents[i] = parents[slot] >= 0 ? nodeIndexes[parents[slot]] : -1;
+
+        /// Stored world matrices are no longer valid
+        flags[slot] |= DIRTY;
+    }
+
+    levelStarts.push_back(depthSlots.size());
+
+    hierarchyChanged = false;
+}
+
+void TransformStorage::storePrevious() {
+    PROFILE_FUNCTION();
+
+    std::copy(positionX.begin(), positionX.end(), previousPositionX.begin());
+    std::copy(positionY.begin(), positionY.end(), previousPositionY.begin());
+    std::copy(positionZ.begin(), positionZ.end(), previousPositionZ.begin());
+
+    std::copy(rotationX.begin(), rotationX.end(), previousRotationX.begin());
+    std::copy(rotationY.begin(), rotationY.end(), previousRotationY.begin());
+    std::copy(rotationZ.begin(), rotationZ.end(), previousRotationZ.begin());
+    std::copy(rotationW.begin(), rotationW.end(), previousRotationW.begin());
+
+    std::copy(scaleX.begin(), scaleX.end(), previousScaleX.begin());
+    std::copy(scaleY.begin(), scaleY.end(), previousScaleY.begin());
+    std::copy(scaleZ.begin(), scaleZ.end(), previousScaleZ.begin());
+
+    /// Transform which moved during last tick was rendered at interpolated state and needs one more matrix at rest
+    for (auto & flag : flags) {
+        flag = (flag | ((flag & CHANGED) >> 1)) & ~CHANGED;
+    }
+}
+
+void TransformStorage::integrateAngularVelocity(const float & deltaTime) {
+    PROFILE_FUNCTION();
+
+    auto & jobs = JobSystem::Instance();
+
+    jobs.parallelFor(0, size(), jobs.defaultGrainSize(size(), 4096), [&](size_t begin, size_t end) {
+        integrateRange(rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(),
+                       angularVelocityX.data(), angularVelocityY.data(), angularVelocityZ.data(),
+                       flags.data(), begin, end, deltaTime);
+    });
+}
+
+void TransformStorage::clearVisible() {
+    for (auto & flag : flags) {
+        flag &= ~(VISIBLE | UPDATED);
+    }
+}
+
+size_t TransformStorage::computeRange(const size_t & begin, const size_t & end, const float & alpha) {
+    TransformStreams streams {
+        positionX.data(), positionY.data(), positionZ.data(),
+        previousPositionX.data(), previousPositionY.data(), previousPositionZ.data(),
+        rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(),
+        previousRotationX.data(), previousRotationY.data(), previousRotationZ.data(), previousRotationW.data(),
+        scaleX.data(), scaleY.data(), scaleZ.data(),
+        previousScaleX.data(), previousScaleY.data(), previousScaleZ.data(),
+        pivotX.data(), pivotY.data(), pivotZ.data()
+    };
+
+    /// Only roots, children are computed level by level once their parents are done
+    const uint8_t required = ALIVE | VISIBLE;
+    const uint8_t checked = ALIVE | VISIBLE | PARENTED;
+    const uint8_t outdated = DIRTY | CHANGED;
+
+    /// Block of matrices, element k of lane l at out[k * BLOCK + l]
+    float out[16 * BLOCK];
+
+    size_t computed = 0;
+
+    for (size_t base = begin; base < end; base += BLOCK) {
+        size_t count = std::min(BLOCK, end - base);
+
+        uint32_t needed = 0;
+
+        for (size_t lane = 0; lane < count; lane++) {
+            uint8_t flag = flags[base + lane];
+
+            if ((flag & checked) == required && (flag & outdated) && (targets[base + lane].matrices || (flag & HAS_CHILDREN))) {
+                needed |= 1u << lane;
+            }
+        }
+
+        if (!needed) continue;
+
+        composeBlock(streams, base, count, alpha, out);
+
+        for (size_t lane = 0; lane < count; lane++) {
+            if (!(needed & (1u << lane))) continue;
+
+            glm::mat4x4 matrix;
+
+            for (int column = 0; column < 4; column++) {
+                for (int row = 0; row < 4; row++) {
+                    matrix[column][row] = out[(column * 4 + row) * BLOCK + lane];
+                }
+            }
+
+            const MatrixTarget & target = targets[base + lane];
+
+            if (target.matrices) {
+                (*target.matrices)[target.index] = matrix;
+            }
+
+            if (flags[base + lane] & HAS_CHILDREN) {
+                nodeWorld[nodeIndexes[base + lane]] = matrix;
+                flags[base + lane] |= UPDATED;
+            }
+
+            flags[base + lane] &= ~DIRTY;
+            computed++;
+        }
+    }
+
+    return computed;
+}
+
+size_t TransformStorage::computeLevel(const size_t & begin, const size_t & end, const float & alpha) {
+    size_t computed = 0;
+
+    for (size_t node = begin; node < end; node++) {
+        uint32_t slot = nodeSlots[node];
+        int32_t parent = nodeParents[node];
+
+        uint8_t flag = flags[slot];
+
+        if (flags[nodeSlots[parent]] & UPDATED) {
+            flag |= DIRTY;
+        }
+
+        /// Hidden subtree keeps dirty flag until it becomes visible
+        if ((flag & VISIBLE) && (flag & (DIRTY | CHANGED))) {
+            glm::mat4x4 world = nodeWorld[parent] * calculateMatrix(slot, alpha);
+
+            const MatrixTarget & target = targets[slot];
+
+            if (target.matrices) {
+                (*target.matrices)[target.index] = world;
+            }
+
+            nodeWorld[node] = world;
+            flag = (flag & ~DIRTY) | UPDATED;
+            computed++;
+        }
+
+        flags[slot] = flag;
+    }
+
+    return computed;
+}
+
+void TransformStorage::computeMatrices(const float & alpha) {
+    PROFILE_FUNCTION();
+
+    if (hierarchyChanged) {
+        rebuildHierarchy();
+    }
+
+    /// Ancestors of visible transforms are needed as well
+    for (size_t node = nodeSlots.size(); node-- > 0;) {
+        int32_t parent = nodeParents[node];
+
+        if (parent >= 0 && (flags[nodeSlots[node]] & VISIBLE)) {
+            flags[nodeSlots[parent]] |= VISIBLE;
+        }
+    }
+
+    auto & jobs = JobSystem::Instance();
+
+    std::atomic<size_t> computed(0);
+
+    /// Grain is a multiple of block size, only the last range has partial block
+    jobs.parallelFor(0, size(), BLOCK * 256, [&](size_t begin, size_t end) {
+        computed += computeRange(begin, end, alpha);
+    });
+
+    /// Level 0 holds roots which were computed above
+    for (size_t level = 1; level + 1 < levelStarts.size(); level++) {
+        size_t begin = levelStarts[level];
+        size_t end = levelStarts[level + 1];
+
+        jobs.parallelFor(begin, end, jobs.defaultGrainSize(end - begin, 1024), [&](size_t rangeBegin, size_t rangeEnd) {
+            computed += computeLevel(rangeBegin, rangeEnd, alpha);
+        });
+    }
+
+    lastComputedCount = computed;
+}
+
+glm::mat4x4 TransformStorage::calculateMatrix(const uint32_t & slot, const float & alpha) const {
+    TransformStreams streams {
+        positionX.data(), positionY.data(), positionZ.data(),
+        previousPositionX.data(), previousPositionY.data(), previousPositionZ.data(),
+        rotationX.data(), rotationY.data(), rotationZ.data(), rotationW.data(),
+        previousRotationX.data(), previousRotationY.data(), previousRotationZ.data(), previousRotationW.data(),
+        scaleX.data(), scaleY.data(), scaleZ.data(),
+        previousScaleX.data(), previousScaleY.data(), previousScaleZ.data(),
+        pivotX.data(), pivotY.data(), pivotZ.data()
+    };
+
+    float m[16];
+    composeMatrix(streams, slot, alpha, m, 1);
+
+    glm::mat4x4 matrix;
+
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            matrix[column][row] = m[column * 4 + row];
+        }
+    }
+
+    return matrix;
+}
+
+glm::mat4x4 TransformStorage::calculateWorldMatrix(const uint32_t & slot, const float & alpha) const {
+    glm::mat4x4 matrix = calculateMatrix(slot, alpha);
+
+    for (int32_t ancestor = parents[slot]; ancestor >= 0; ancestor = parents[ancestor]) {
+        matrix = calculateMatrix(ancestor, alpha) * matrix;
+    }
+
+    return matrix;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm/glm.hpp>
+
+/// Instance matrix a transform writes its world matrix into
+struct MatrixTarget {
+    std::vector<glm::mat4x4> * matrices = nullptr;
+    int index = 0;
+};
+
+/// Structure-of-arrays storage of all transforms.
+///
+/// Every Transform owns one slot. Simulation writes current state, tick start copies it to previous state
+/// and matrices are computed in batch for visible transforms that changed, interpolated between both states,
+/// and written straight into instance arrays of meshes.
+///
+/// Transforms may have parents. Transforms in hierarchies are kept in depth sorted order, world matrices
+/// are derived from parents level by level, and only subtrees that changed are recomputed.
+/// Transforms without parents are computed in blocks, as before.
+///
+/// Slots are allocated and released on main thread, outside of frame preparation.
+class TransformStorage {
+
+    friend class Transform;
+
+    public:
+
+        enum Flags : uint8_t {
+            ALIVE = 1,
+
+            /// Matrix has to be recomputed even if transform does not interpolate
+            DIRTY = 2,
+
+            /// Changed since last tick start - rendered matrix depends on interpolation alpha
+            CHANGED = 4,
+
+            /// Matrix is needed this frame
+            VISIBLE = 8,
+
+            /// Orientation is integrated from angular velocity every tick
+            SPINNING = 16,
+
+            /// Local state is relative to parent transform
+            PARENTED = 32,
+
+            /// World matrix is kept for children
+            HAS_CHILDREN = 64,
+
+            /// World matrix was recomputed this frame, children have to follow
+            UPDATED = 128
+        };
+
+    private:
+
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> previousPositionX, previousPositionY, previousPositionZ;
+
+        /// Orientation quaternions
+        std::vector<float> rotationX, rotationY, rotationZ, rotationW;
+        std::vector<float> previousRotationX, previousRotationY, previousRotationZ, previousRotationW;
+
+        std::vector<float> scaleX, scaleY, scaleZ;
+        std::vector<float> previousScaleX, previousScaleY, previousScaleZ;
+
+        /// Offset applied after scale and before rotation (bounding boxes)
+        std::vector<float> pivotX, pivotY, pivotZ;
+
+        /// Euler angle rates in radians per second
+        std::vector<float> angularVelocityX, angularVelocityY, angularVelocityZ;
+
+        std::vector<uint8_t> flags;
+
+        std::vector<MatrixTarget> targets;
+
+        std::vector<uint32_t> freeSlots;
+
+        /// Parent slot or -1
+        std::vector<int32_t> parents;
+        std::vector<uint32_t> childCounts;
+
+        /// Transforms with parent or children, sorted by depth - parent always precedes its children
+        std::vector<uint32_t> nodeSlots;
+
+        /// Index of parent node or -1 for roots
+        std::vector<int32_t> nodeParents;
+
+        /// World matrices of nodes
+        std::vector<glm::mat4x4> nodeWorld;
+
+        /// Node of every slot or -1
+        std::vector<int32_t> nodeIndexes;
+
+        /// First node of every depth level, last entry is node count
+        std::vector<size_t> levelStarts;
+
+        bool hierarchyChanged = false;
+
+        size_t lastComputedCount = 0;
+
+        size_t computeRange(const size_t & begin, const size_t & end, const float & alpha);
+
+        size_t computeLevel(const size_t & begin, const size_t & end, const float & alpha);
+
+        void rebuildHierarchy();
+
+    public:
+
+        /// Never destroyed - transforms of objects released during static destruction still free their slots
+        static TransformStorage & Instance() {
+            static TransformStorage * instance = new TransformStorage();
+            return *instance;
+        }
+
+        uint32_t allocate();
+
+        /// Grows arrays once before creating count transforms in bulk
+        void reserve(const size_t & count);
+
+        /// Children of released slot become roots
+        void release(const uint32_t & slot);
+
+        /// Attaches slot to parent slot, -1 detaches. Fails when parent is slot itself or its descendant.
+        bool setParent(const uint32_t & slot, const int32_t & parent);
+
+        int32_t getParent(const uint32_t & slot) const { return parents[slot]; }
+
+        /// Number of slots including released ones
+        size_t size() const { return flags.size(); }
+
+        size_t getLastComputedCount() const { return lastComputedCount; }
+
+        /// Copies current state of all transforms to previous state (start of simulation tick)
+        void storePrevious();
+
+        /// Applies angular velocity of spinning transforms for one fixed step
+        void integrateAngularVelocity(const float & deltaTime);
+
+        void clearVisible();
+
+        void markVisible(const uint32_t & slot) { flags[slot] |= VISIBLE; }
+
+        /// Computes matrices of visible transforms which are dirty or interpolating
+        void computeMatrices(const float & alpha);
+
+        /// Single transform matrix relative to parent, same math as batched path
+        glm::mat4x4 calculateMatrix(const uint32_t & slot, const float & alpha) const;
+
+        /// World matrix computed through all parents, for queries made before computeMatrices
+        glm::mat4x4 calculateWorldMatrix(const uint32_t & slot, const float & alpha) const;
+};
@@ -8,6 +8,9 @@ class Settings {
 
         std::shared_ptr<BooleanProperty> showNormalsProperty;
 
+        /// Prepare next frame on background thread while current one is submitted
+        std::shared_ptr<BooleanProperty> pipelinedFramesProperty;
+
         static Settings & Instance()
         {
             static Settings instance;
@@ -16,10 +19,13 @@ class Settings {
 
         Settings() {
             showNormalsProperty = std::make_shared<BooleanProperty>(false);
+            pipelinedFramesProperty = std::make_shared<BooleanProperty>(false);
         };
 
         bool getShowNormals() { return showNormalsProperty->getValue(); }
 
+        bool getPipelinedFrames() { return pipelinedFramesProperty->getValue(); }
+
     public:
 
         void operator=(Settings const&)  = delete;
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cmath>
+
+/// Frame and simulation clock shared by the whole engine.
+/// Simulation runs in fixed steps of fixedDeltaTime, rendering runs at whatever rate it can
+/// and interpolates transforms between two last simulation ticks using interpolationAlpha.
+class Time {
+
+    private:
+
+        Time() = default;
+
+    public:
+
+        /// Length of single simulation tick in seconds
+        double fixedDeltaTime = 1.0 / 60.0;
+
+        /// Upper bound of ticks run per rendered frame. When rendering is slower than that,
+        /// simulation slows down instead of spending even more time catching up (spiral of death)
+        int maxStepsPerFrame = 5;
+
+        /// Longest frame time accepted, protects against huge steps after stalls (debugger, window drag)
+        double maxFrameTime = 0.25;
+
+        /// Duration of last rendered frame in seconds
+        double deltaTime = 0.0;
+
+        /// Time simulated so far in seconds
+        double simulationTime = 0.0;
+
+        /// Not yet simulated time, always smaller than fixedDeltaTime after advance()
+        double accumulator = 0.0;
+
+        /// Position of rendered frame between previous (0.0) and current (1.0) simulation tick
+        float interpolationAlpha = 1.0f;
+
+        uint64_t tick = 0;
+
+        /// Read by editor while simulation may run on frame pipeline thread
+        std::atomic<uint64_t> droppedTicks { 0 };
+
+        static Time & Instance() {
+            static Time instance;
+            return instance;
+        }
+
+        Time(Time const &) = delete;
+
+        void operator=(Time const &) = delete;
+
+        /// Called on main thread at the beginning of every rendered frame
+        void beginFrame(const double & frameTime) {
+            deltaTime = frameTime;
+        }
+
+        /// Accumulates frame time and returns number of fixed ticks that should run this frame
+        int advance(const double & frameTime) {
+            accumulator += frameTime < maxFrameTime ? frameTime : maxFrameTime;
+
+            auto steps = static_cast<int>(accumulator / fixedDeltaTime);
+
+            if (steps > maxStepsPerFrame) {
+                droppedTicks += static_cast<uint64_t>(steps - maxStepsPerFrame);
+                accumulator = std::fmod(accumulator, fixedDeltaTime) + maxStepsPerFrame * fixedDeltaTime;
+                steps = maxStepsPerFrame;
+            }
+
+            return steps;
+        }
+
+        /// Called after each simulated tick
+        void endTick() {
+            accumulator -= fixedDeltaTime;
+            simulationTime += fixedDeltaTime;
+            tick++;
+        }
+
+        /// Called once all ticks of current frame are simulated
+        void updateInterpolation() {
+            interpolationAlpha = static_cast<float>(accumulator / fixedDeltaTime);
+        }
+
+        float getFixedDeltaTime() const { return static_cast<float>(fixedDeltaTime); }
+
+        float getDeltaTime() const { return static_cast<float>(deltaTime); }
+};
@@ -10,4 +10,8 @@
 class BoundingBoxGenerator {
     public:
         static std::shared_ptr<BoundingBoxObject> calculateBoundingBox(const std::shared_ptr<Mesh> & mesh, const std::shared_ptr<GameObjectBase> & child);
+
+        /// Copies cached bounds of mesh into child and places its bounding box object (if any), called after
+        /// mesh geometry changed. Cost does not depend on vertex count once mesh bounds are computed.
+        static void fitBoundingBox(const std::shared_ptr<Mesh> & mesh, GameObjectBase & child);
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+    #define FAST_MATH_INLINE __forceinline
+#else
+    /// Calls left in a loop stop vectorization, so inlining must not depend on size heuristics
+    #define FAST_MATH_INLINE inline __attribute__((always_inline))
+#endif
+
+/// Branch free math for loops over float arrays. Functions contain only arithmetic and selects,
+/// so compiler can vectorize loops calling them.
+class FastMath {
+    public:
+
+        /// Sine and cosine with error below 1e-6 for |x| < 1e4 (Cephes polynomials)
+        static FAST_MATH_INLINE void sinCos(const float & x, float & s, float & c) {
+            const float fourOverPi = 1.27323954473516f;
+
+            const float dp1 = 0.78515625f;
+            const float dp2 = 2.4187564849853515625e-4f;
+            const float dp3 = 3.77489497744594108e-8f;
+
+            float xa = x < 0.0f ? -x : x;
+
+            /// Octant, rounded to even so that reduced argument lies in [-pi/4, pi/4]
+            int32_t j = static_cast<int32_t>(xa * fourOverPi);
+            j = (j + 1) & ~1;
+
+            float y = static_cast<float>(j);
+            float r = ((xa - y * dp1) - y * dp2) - y * dp3;
+            float z = r * r;
+
+            float polyCos = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+            float polySin = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+
+            bool swap = (j & 2) != 0;
+
+            float sinValue = swap ? polyCos : polySin;
+            float cosValue = swap ? polySin : polyCos;
+
+            bool sinNegative = ((j & 4) != 0) != (x < 0.0f);
+            bool cosNegative = ((j - 2) & 4) == 0;
+
+            s = sinNegative ? -sinValue : sinValue;
+            c = cosNegative ? -cosValue : cosValue;
+        }
+
+        /// 1 / sqrt(x) for x > 0, relative error below 2e-7.
+        /// std::sqrt may set errno, which keeps compiler from vectorizing loops that call it.
+        static FAST_MATH_INLINE float inverseSqrt(const float & x) {
+            int32_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            bits = 0x5f375a86 - (bits >> 1);
+
+            float y;
+            std::memcpy(&y, &bits, sizeof(y));
+
+            float halfX = 0.5f * x;
+
+            y = y * (1.5f - halfX * y * y);
+            y = y * (1.5f - halfX * y * y);
+            y = y * (1.5f - halfX * y * y);
+
+            return y;
+        }
+};
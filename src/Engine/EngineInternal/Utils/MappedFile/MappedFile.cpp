@@ -0,0 +1,111 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string & path) {
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(handle);
+        return;
+    }
+
+    HANDLE fileMapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (!fileMapping) {
+        CloseHandle(handle);
+        return;
+    }
+
+    void * view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (!view) {
+        CloseHandle(fileMapping);
+        CloseHandle(handle);
+        return;
+    }
+
+    file = handle;
+    mapping = fileMapping;
+    data = static_cast<const unsigned char *>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return;
+
+    struct stat status {};
+
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        ::close(descriptor);
+        return;
+    }
+
+    void * view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+    /// Mapping keeps its own reference to the file
+    ::close(descriptor);
+
+    if (view == MAP_FAILED) return;
+
+    /// Whole file is read front to back, let the OS read ahead
+    madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+
+    data = static_cast<const unsigned char *>(view);
+    size = static_cast<size_t>(status.st_size);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile && other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile & MappedFile::operator=(MappedFile && other) noexcept {
+    if (this == &other) return *this;
+
+    close();
+
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+
+#ifdef _WIN32
+    std::swap(file, other.file);
+    std::swap(mapping, other.mapping);
+#endif
+
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::close() {
+    if (!data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    CloseHandle(file);
+    file = nullptr;
+    mapping = nullptr;
+#else
+    munmap(const_cast<unsigned char *>(data), size);
+#endif
+
+    data = nullptr;
+    size = 0;
+}
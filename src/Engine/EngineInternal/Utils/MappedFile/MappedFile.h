@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// Read-only memory mapping of whole file. Pages are loaded by the OS when touched.
+class MappedFile {
+
+    private:
+
+        const unsigned char * data = nullptr;
+        size_t size = 0;
+
+#ifdef _WIN32
+        void * file = nullptr;
+        void * mapping = nullptr;
+#endif
+
+        void close();
+
+    public:
+
+        MappedFile() = default;
+
+        /// Maps file, isOpen() is false when it does not exist or cannot be mapped
+        explicit MappedFile(const std::string & path);
+
+        MappedFile(const MappedFile & other) = delete;
+
+        MappedFile & operator=(const MappedFile & other) = delete;
+
+        MappedFile(MappedFile && other) noexcept;
+
+        MappedFile & operator=(MappedFile && other) noexcept;
+
+        ~MappedFile();
+
+        bool isOpen() const { return data != nullptr; }
+
+        const unsigned char * getData() const { return data; }
+
+        size_t getSize() const { return size; }
+};
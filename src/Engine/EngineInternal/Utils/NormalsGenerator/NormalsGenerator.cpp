@@ -1,51 +1,144 @@
 #include "NormalsGenerator.h"
 
-void NormalsGenerator::generate(Mesh * mesh) {
-    std::map<unsigned int, std::vector<TriangleInfo>> vertexToTriangles;
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <Jobs/JobSystem/JobSystem.h>
+#include <Profiling/Profile.h>
 
-    std::vector<TriangleInfo> triangles;
+namespace {
 
-    auto vertices = mesh->vertices;
+    /// Polynomial arc cosine (Abramowitz and Stegun 4.4.45), error below 1e-4 radians is enough for weights
+    inline float cornerAngle(const float & dot, const float & lengthSquaredA, const float & lengthSquaredB) {
+        float cosine = dot / std::sqrt(lengthSquaredA * lengthSquaredB);
+        float x = std::min(1.0f, std::fabs(cosine));
 
-    for (unsigned int vertexId = 0; vertexId < vertices.size() / 3; vertexId++) {
-        vertexToTriangles.insert(std::pair<int, std::vector<TriangleInfo>>(vertexId, triangles));
+        float angle = std::sqrt(1.0f - x) * (1.5707288f + x * (-0.2121144f + x * (0.0742610f - 0.0187293f * x)));
+
+        return cosine < 0.0f ? 3.14159265f - angle : angle;
     }
 
-    auto indices = mesh->indices;
+    /// Adds angle weighted normal of triangles [begin, end) to its vertices
+    void accumulate(const MeshArray<float> & vertices, const MeshArray<unsigned int> & indices,
+                    const size_t & begin, const size_t & end, float * normals) {
+        const float * v = vertices.data;
+        const unsigned int * index = indices.data;
 
-    for (unsigned int j = 0; j < indices.size() / 3; j++) {
-        unsigned int v1 = indices[j * 3];
-        unsigned int v2 = indices[j * 3 + 1];
-        unsigned int v3 = indices[j * 3 + 2];
+        for (size_t triangle = begin; triangle < end; triangle++) {
+            const unsigned int i0 = index[triangle * 3] * 3;
+            const unsigned int i1 = index[triangle * 3 + 1] * 3;
+            const unsigned int i2 = index[triangle * 3 + 2] * 3;
 
-        glm::vec3 v_1 = glm::vec3(vertices[v1 * 3], vertices[v1 * 3 + 1], vertices[v1 * 3 + 2]);
-        glm::vec3 v_2 = glm::vec3(vertices[v2 * 3], vertices[v2 * 3 + 1], vertices[v2 * 3 + 2]);
-        glm::vec3 v_3 = glm::vec3(vertices[v3 * 3], vertices[v3 * 3 + 1], vertices[v3 * 3 + 2]);
+            /// Edges from each corner
+            const float e01x = v[i1] - v[i0], e01y = v[i1 + 1] - v[i0 + 1], e01z = v[i1 + 2] - v[i0 + 2];
+            const float e02x = v[i2] - v[i0], e02y = v[i2 + 1] - v[i0 + 1], e02z = v[i2 + 2] - v[i0 + 2];
+            const float e12x = v[i2] - v[i1], e12y = v[i2 + 1] - v[i1 + 1], e12z = v[i2 + 2] - v[i1 + 2];
 
-        glm::vec3 a = v_2 - v_1;
-        glm::vec3 b = v_3 - v_1;
+            float nx = e01y * e02z - e01z * e02y;
+            float ny = e01z * e02x - e01x * e02z;
+            float nz = e01x * e02y - e01y * e02x;
 
-        TriangleInfo info{};
-        info.angle = std::acos(dot(a, b) / (length(a) * length(b)));
-        info.normal = normalize(cross(a, b));
+            const float lengthSquared = nx * nx + ny * ny + nz * nz;
 
-        vertexToTriangles.at(v1).emplace_back(info);
-        vertexToTriangles.at(v2).emplace_back(info);
-        vertexToTriangles.at(v3).emplace_back(info);
-    }
+            /// Degenerate triangle has no direction
+            if (lengthSquared <= 0.0f) continue;
 
-    for (auto & pair : vertexToTriangles) {
+            const float inverseLength = 1.0f / std::sqrt(lengthSquared);
+            nx *= inverseLength;
+            ny *= inverseLength;
+            nz *= inverseLength;
 
-        std::vector<TriangleInfo> triangleInfos = pair.second;
+            const float l01 = e01x * e01x + e01y * e01y + e01z * e01z;
+            const float l02 = e02x * e02x + e02y * e02y + e02z * e02z;
+            const float l12 = e12x * e12x + e12y * e12y + e12z * e12z;
 
-        glm::vec3 weightedSum = glm::vec3(0.0, 0.0, 0.0);
+            const float angle0 = cornerAngle(e01x * e02x + e01y * e02y + e01z * e02z, l01, l02);
+            const float angle1 = cornerAngle(-(e01x * e12x + e01y * e12y + e01z * e12z), l01, l12);
+            const float angle2 = 3.14159265f - angle0 - angle1;
 
-        for (auto & info : triangleInfos) {
-            weightedSum += info.normal * info.angle;
+            normals[i0] += nx * angle0;
+            normals[i0 + 1] += ny * angle0;
+            normals[i0 + 2] += nz * angle0;
+
+            normals[i1] += nx * angle1;
+            normals[i1 + 1] += ny * angle1;
+            normals[i1 + 2] += nz * angle1;
+
+            normals[i2] += nx * std::max(0.0f, angle2);
+            normals[i2 + 1] += ny * std::max(0.0f, angle2);
+            normals[i2 + 2] += nz * std::max(0.0f, angle2);
         }
+    }
+}
 
-        weightedSum /= triangleInfos.size();
+void NormalsGenerator::generate(Mesh * mesh) {
+    PROFILE_FUNCTION();
+
+    auto vertices = mesh->getVertices();
+    auto indices = mesh->getIndices();
+
+    size_t vertexCount = vertices.size / 3;
+    size_t triangleCount = indices.size / 3;
+
+    mesh->normals.assign(vertexCount * 3, 0.0f);
 
-        mesh->normals.insert(mesh->normals.end(), {weightedSum.x, weightedSum.y, weightedSum.z});
+    for (size_t i = 0; i < triangleCount * 3; i++) {
+        if (indices[i] >= vertexCount) {
+            std::cerr << "NormalsGenerator: index out of range in " << mesh->meshId << std::endl;
+            return;
+        }
     }
+
+    auto & jobs = JobSystem::Instance();
+
+    /// Every range needs its own array, so there are no more ranges than threads
+    size_t rangeCount = std::max<size_t>(1, std::min<size_t>(jobs.getWorkerCount() + 1, triangleCount / MIN_TRIANGLES_PER_RANGE));
+    size_t rangeSize = (triangleCount + rangeCount - 1) / std::max<size_t>(1, rangeCount);
+
+    std::vector<std::vector<float>> partials(rangeCount - 1);
+
+    jobs.parallelFor(0, rangeCount, 1, [&](size_t first, size_t last) {
+        for (size_t range = first; range < last; range++) {
+            float * normals = mesh->normals.data();
+
+            if (range > 0) {
+                partials[range - 1].assign(vertexCount * 3, 0.0f);
+                normals = partials[range - 1].data();
+            }
+
+            size_t begin = range * rangeSize;
+            size_t end = std::min(triangleCount, begin + rangeSize);
+
+            accumulate(vertices, indices, begin, end, normals);
+        }
+    });
+
+    jobs.parallelFor(0, vertexCount, jobs.defaultGrainSize(vertexCount, 4096), [&](size_t first, size_t last) {
+        float * normals = mesh->normals.data();
+
+        for (auto & partial : partials) {
+            for (size_t i = first * 3; i < last * 3; i++) {
+                normals[i] += partial[i];
+            }
+        }
+
+        for (size_t vertex = first; vertex < last; vertex++) {
+            float * normal = normals + vertex * 3;
+
+            float lengthSquared = normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2];
+
+            /// Vertices without triangles point up
+            if (lengthSquared <= 0.0f) {
+                normal[1] = 1.0f;
+                continue;
+            }
+
+            float inverseLength = 1.0f / std::sqrt(lengthSquared);
+
+            normal[0] *= inverseLength;
+            normal[1] *= inverseLength;
+            normal[2] *= inverseLength;
+        }
+    });
 }
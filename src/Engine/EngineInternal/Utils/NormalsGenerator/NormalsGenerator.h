@@ -2,12 +2,16 @@
 
 #include <Rendering/Mesh/Mesh.h>
 
-struct TriangleInfo {
-    float angle;
-    glm::vec3 normal;
-};
-
+/// Smooth vertex normals - face normals weighted by corner angles, summed per vertex and normalized.
+///
+/// Triangles are split into ranges accumulated in parallel, each range into its own array (first one into output),
+/// arrays are then summed and normalized in parallel over vertex ranges. Time is linear in triangle count.
 class NormalsGenerator {
+
     public:
+
+        /// Triangles per accumulation range, smaller meshes use single range
+        static constexpr size_t MIN_TRIANGLES_PER_RANGE = 64 * 1024;
+
         static void generate(Mesh * mesh);
-};
\ No newline at end of file
+};
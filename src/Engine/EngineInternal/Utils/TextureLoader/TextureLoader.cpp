@@ -1,9 +1,31 @@
 #include "TextureLoader.h"
 
+#include <mutex>
+#include <unordered_map>
+
+#include <Profiling/MemoryTracker/MemoryTracker.h>
+
 #define STB_IMAGE_IMPLEMENTATION
 
 #include "stb_image/stb_image.h"
 
+namespace {
+
+    /// GL_RGB with 8 bits per channel
+    const size_t BYTES_PER_TEXEL = 3;
+
+    std::mutex texturesMutex;
+
+    /// Bytes of every live texture, so deleting knows how much to remove
+    std::unordered_map<GLuint, size_t> textureBytes;
+
+    void trackTexture(const GLuint & textureId, const size_t & bytes) {
+        std::lock_guard<std::mutex> lock(texturesMutex);
+        textureBytes[textureId] = bytes;
+        MemoryTracker::Instance().add(MemoryCategory::GPU_TEXTURES, bytes);
+    }
+}
+
 TextureInfo TextureLoader::loadTextureData(const char * path) {
     int width, height, nrChannels;
     stbi_set_flip_vertically_on_load(true);
@@ -24,11 +46,21 @@ GLuint TextureLoader::loadCubeMap(const std::vector<std::string> & paths) {
 
     unsigned char * data;
 
+    size_t bytes = 0;
+
     for (GLuint i = 0; i < 6; i++) {
         data = stbi_load(paths[i].c_str(), &width, &height, &nrChannels, 0);
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+
+        if (data) {
+            bytes += static_cast<size_t>(width) * height * BYTES_PER_TEXEL;
+        }
+
+        stbi_image_free(data);
     }
 
+    trackTexture(textureID, bytes);
+
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -45,7 +77,26 @@ GLuint TextureLoader::generateAndBindTexture(const TextureInfo & info) {
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, info.width, info.height, 0, GL_RGB, GL_UNSIGNED_BYTE, info.data);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    trackTexture(textureID, info.data ? static_cast<size_t>(info.width) * info.height * BYTES_PER_TEXEL : 0);
+
     return textureID;
 }
 
+void TextureLoader::deleteTexture(const GLuint & textureId) {
+    glDeleteTextures(1, &textureId);
+
+    std::lock_guard<std::mutex> lock(texturesMutex);
 
+    auto it = textureBytes.find(textureId);
+
+    if (it == textureBytes.end()) return;
+
+    MemoryTracker::Instance().remove(MemoryCategory::GPU_TEXTURES, it->second);
+    textureBytes.erase(it);
+}
+
+void TextureLoader::freeTextureData(TextureInfo & info) {
+    stbi_image_free(info.data);
+    info.data = nullptr;
+}
@@ -16,4 +16,10 @@ class TextureLoader {
         static TextureInfo loadTextureData(const char * path);
         static GLuint loadCubeMap(const std::vector<std::string> & paths);
         static GLuint generateAndBindTexture(const TextureInfo & info);
+
+        /// Deletes texture created by this loader, its size is removed from MemoryTracker
+        static void deleteTexture(const GLuint & textureId);
+
+        /// Frees pixels returned by loadTextureData, call after texture is uploaded
+        static void freeTextureData(TextureInfo & info);
 };
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "VertexWelder.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <Profiling/Profile.h>
+#include <Utils/NormalsGenerator/NormalsGenerator.h>
+
+namespace {
+
+    struct Slot {
+        ObjIndex key;
+        uint32_t vertex = std::numeric_limits<uint32_t>::max();
+    };
+
+    inline uint32_t hashIndex(const ObjIndex & index) {
+        uint32_t hash = static_cast<uint32_t>(index.vertex) * 0x9E3779B1u;
+        hash ^= static_cast<uint32_t>(index.texcoord) * 0x85EBCA77u;
+        hash ^= static_cast<uint32_t>(index.normal) * 0xC2B2AE3Du;
+
+        /// Final mix of murmur3, low bits select the slot
+        hash ^= hash >> 16;
+        hash *= 0x85EBCA6Bu;
+        hash ^= hash >> 13;
+
+        return hash;
+    }
+
+    inline bool sameIndex(const ObjIndex & a, const ObjIndex & b) {
+        return a.vertex == b.vertex && a.texcoord == b.texcoord && a.normal == b.normal;
+    }
+}
+
+void VertexWelder::weld(const ObjData & data, Mesh & mesh) {
+    PROFILE_FUNCTION();
+
+    bool hasNormals = !data.indices.empty() && std::all_of(data.indices.begin(), data.indices.end(), [](const ObjIndex & index) {
+        return index.normal >= 0;
+    });
+
+    bool hasTexcoords = std::any_of(data.indices.begin(), data.indices.end(), [](const ObjIndex & index) {
+        return index.texcoord >= 0;
+    });
+
+    /// Normals are ignored in keys when they are not kept, so vertices differing only by normal are welded
+    auto key = [&hasNormals, &hasTexcoords](ObjIndex index) {
+        if (!hasNormals) index.normal = -1;
+        if (!hasTexcoords) index.texcoord = -1;
+        return index;
+    };
+
+    /// At most half full
+    size_t capacity = 16;
+
+    while (capacity < data.indices.size() * 2) {
+        capacity *= 2;
+    }
+
+    std::vector<Slot> slots(capacity);
+    size_t mask = capacity - 1;
+
+    mesh.vertices.clear();
+    mesh.uvs.clear();
+    mesh.normals.clear();
+    mesh.indices.clear();
+
+    mesh.indices.reserve(data.indices.size());
+
+    /// Position of every welded vertex, generated normals are looked up by it
+    std::vector<uint32_t> vertexPositions;
+
+    for (const auto & corner : data.indices) {
+        ObjIndex index = key(corner);
+
+        size_t position = hashIndex(index) & mask;
+
+        while (slots[position].vertex != std::numeric_limits<uint32_t>::max() && !sameIndex(slots[position].key, index)) {
+            position = (position + 1) & mask;
+        }
+
+        Slot & slot = slots[position];
+
+        if (slot.vertex == std::numeric_limits<uint32_t>::max()) {
+            slot.key = index;
+            slot.vertex = static_cast<uint32_t>(mesh.vertices.size() / 3);
+
+            auto v = static_cast<size_t>(index.vertex) * 3;
+            mesh.vertices.insert(mesh.vertices.end(), { data.positions[v], data.positions[v + 1], data.positions[v + 2] });
+
+            if (hasTexcoords) {
+                if (index.texcoord >= 0) {
+                    auto t = static_cast<size_t>(index.texcoord) * 2;
+                    mesh.uvs.insert(mesh.uvs.end(), { data.texcoords[t], data.texcoords[t + 1] });
+                }
+                else {
+                    mesh.uvs.insert(mesh.uvs.end(), { 0.0f, 0.0f });
+                }
+            }
+
+            if (hasNormals) {
+                auto n = static_cast<size_t>(index.normal) * 3;
+                mesh.normals.insert(mesh.normals.end(), { data.normals[n], data.normals[n + 1], data.normals[n + 2] });
+            }
+            else {
+                vertexPositions.push_back(static_cast<uint32_t>(index.vertex));
+            }
+        }
+
+        mesh.indices.push_back(slot.vertex);
+    }
+
+    if (!hasNormals && !mesh.indices.empty()) {
+        generateNormals(data, vertexPositions, mesh);
+    }
+}
+
+void VertexWelder::generateNormals(const ObjData & data, const std::vector<uint32_t> & vertexPositions, Mesh & mesh) {
+    PROFILE_FUNCTION();
+
+    /// Vertices split by texture coordinates share one position, so normals are generated over positions
+    /// and copies of a position get the same normal - no hard edges at UV seams
+    Mesh positions;
+    positions.meshId = mesh.meshId;
+    positions.vertices = data.positions;
+
+    positions.indices.reserve(data.indices.size());
+
+    for (const auto & corner : data.indices) {
+        positions.indices.push_back(static_cast<unsigned int>(corner.vertex));
+    }
+
+    NormalsGenerator::generate(&positions);
+
+    mesh.normals.resize(vertexPositions.size() * 3);
+
+    for (size_t vertex = 0; vertex < vertexPositions.size(); vertex++) {
+        auto n = static_cast<size_t>(vertexPositions[vertex]) * 3;
+
+        mesh.normals[vertex * 3] = positions.normals[n];
+        mesh.normals[vertex * 3 + 1] = positions.normals[n + 1];
+        mesh.normals[vertex * 3 + 2] = positions.normals[n + 2];
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Rendering/Mesh/Mesh.h>
+#include <Rendering/Mesh/ObjParser/ObjParser.h>
+
+/// Builds indexed mesh from OBJ corners. Every unique (position, texcoord, normal) index triplet becomes one vertex,
+/// triplets are looked up in open addressing hash table (linear probing, power of two capacity).
+///
+/// File normals are kept when every corner has one, otherwise smooth normals are generated per position
+/// and copied to all vertices sharing it. Texture coordinates are kept when any corner has them, corners without are (0, 0).
+class VertexWelder {
+
+    private:
+
+        /// vertexPositions holds position index of every welded vertex
+        static void generateNormals(const ObjData & data, const std::vector<uint32_t> & vertexPositions, Mesh & mesh);
+
+    public:
+
+        static void weld(const ObjData & data, Mesh & mesh);
+};
@@ -9,6 +9,11 @@ std::shared_ptr<Scene> instancedScene() {
 
     srand (static_cast <unsigned> (time(0)));
 
+    const size_t count = 40 * 40 * 40;
+
+    GameObjectFactory::reserve(count);
+    reservePooled<Rigidbody, Rotator>(count);
+
     for (int x = 0; x < 40; x++) {
         for (int y = 0; y < 40; y++) {
             for (int z = 0; z < 40; z++) {
@@ -23,12 +28,12 @@ std::shared_ptr<Scene> instancedScene() {
                         glm::vec4(r, g, b, 1.0f)
                 );
 
-                auto rigidbody = std::make_shared<Rigidbody>();
+                auto rigidbody = makePooled<Rigidbody>();
                 rigidbody->mass = 1.0f;
                 rigidbody->restitution = 0.2f;
 
                 cube->addComponent(rigidbody);
-                cube->addComponent(std::make_shared<Rotator>());
+                cube->addComponent(makePooled<Rotator>());
 
                 scene->addChild(cube);
             }
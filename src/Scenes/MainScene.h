@@ -8,26 +8,26 @@ std::shared_ptr<Scene> mainScene() {
 
     auto lightPos = std::make_shared<glm::vec3>(2.2f, 3.0f, 2.0f);
 
-    auto lampMesh = std::make_shared<MeshComponent>();
-    auto lampMeshRenderer = std::make_shared<MeshRenderer>();
+    auto lampMesh = makePooled<MeshComponent>();
+    auto lampMeshRenderer = makePooled<MeshRenderer>();
 
-    auto cubeMesh= std::make_shared<MeshComponent>();
-    auto cubeMeshRenderer = std::make_shared<MeshRenderer>();
+    auto cubeMesh= makePooled<MeshComponent>();
+    auto cubeMeshRenderer = makePooled<MeshRenderer>();
 
-    auto bunnyMesh = std::make_shared<MeshComponent>();
-    auto bunnyMeshRenderer = std::make_shared<MeshRenderer>();
+    auto bunnyMesh = makePooled<MeshComponent>();
+    auto bunnyMeshRenderer = makePooled<MeshRenderer>();
 
-    auto suzanneMesh = std::make_shared<MeshComponent>();
-    auto suzanneMeshRenderer = std::make_shared<MeshRenderer>();
+    auto suzanneMesh = makePooled<MeshComponent>();
+    auto suzanneMeshRenderer = makePooled<MeshRenderer>();
 
-    auto teapotMesh = std::make_shared<MeshComponent>();
-    auto teapotMeshRenderer = std::make_shared<MeshRenderer>();
+    auto teapotMesh = makePooled<MeshComponent>();
+    auto teapotMeshRenderer = makePooled<MeshRenderer>();
 
-    auto coneMesh = std::make_shared<MeshComponent>();
-    auto coneMeshRenderer = std::make_shared<MeshRenderer>();
+    auto coneMesh = makePooled<MeshComponent>();
+    auto coneMeshRenderer = makePooled<MeshRenderer>();
 
-    auto surfaceMesh = std::make_shared<MeshComponent>();
-    auto surfaceMeshRenderer = std::make_shared<MeshRenderer>();
+    auto surfaceMesh = makePooled<MeshComponent>();
+    auto surfaceMeshRenderer = makePooled<MeshRenderer>();
 
     cubeMesh->meshType = CUBE;
     cubeMeshRenderer->shaderType = PHONG;
@@ -62,52 +62,52 @@ std::shared_ptr<Scene> mainScene() {
     lampMeshRenderer->color = glm::vec4(1.0, 1.0, 1.0f, 1.0f);
     lampMeshRenderer->instanced = true;
 
-    auto rigidbody = std::make_shared<Rigidbody>();
+    auto rigidbody = makePooled<Rigidbody>();
     rigidbody->mass = 1.0f;
     rigidbody->restitution = 0.2f;
 
-    auto lampMeshObject = std::make_shared<GameObject>();
+    auto lampMeshObject = makePooled<GameObject>();
     lampMeshObject->addComponent(lampMesh);
     lampMeshObject->addComponent(lampMeshRenderer);
 
-    auto cubeObject = std::make_shared<GameObject>();
+    auto cubeObject = makePooled<GameObject>();
     cubeObject->addComponent(cubeMesh);
     cubeObject->addComponent(cubeMeshRenderer);
     cubeObject->addComponent(rigidbody);
 
-    auto bunnyObject = std::make_shared<GameObject>();
+    auto bunnyObject = makePooled<GameObject>();
     bunnyObject->addComponent(bunnyMesh);
     bunnyObject->addComponent(bunnyMeshRenderer);
     bunnyObject->addComponent(rigidbody);
 
-    auto suzanneMeshObject = std::make_shared<GameObject>();
+    auto suzanneMeshObject = makePooled<GameObject>();
     suzanneMeshObject->addComponent(suzanneMesh);
     suzanneMeshObject->addComponent(suzanneMeshRenderer);
     suzanneMeshObject->addComponent(rigidbody);
 
-    auto teapotMeshObject = std::make_shared<GameObject>();
+    auto teapotMeshObject = makePooled<GameObject>();
     teapotMeshObject->addComponent(teapotMesh);
     teapotMeshObject->addComponent(teapotMeshRenderer);
     teapotMeshObject->addComponent(rigidbody);
 
-    auto surfaceObject = std::make_shared<GameObject>();
+    auto surfaceObject = makePooled<GameObject>();
     surfaceObject->addComponent(surfaceMesh);
     surfaceObject->addComponent(surfaceMeshRenderer);
 
-    lampMeshObject->transform.scale = glm::vec3(0.1f);
-    lampMeshObject->transform.position = *lightPos.get();
+    lampMeshObject->transform().setScale(glm::vec3(0.1f));
+    lampMeshObject->transform().setPosition(*lightPos.get());
 
-    cubeObject->transform.position = glm::vec3(2.0f, 0.5f, 0.0f);
+    cubeObject->transform().setPosition(glm::vec3(2.0f, 0.5f, 0.0f));
 
-    bunnyObject->transform.scale = glm::vec3(20.0f);
+    bunnyObject->transform().setScale(glm::vec3(20.0f));
 
-    suzanneMeshObject->transform.position = glm::vec3(0.0f, 5.0f, 0.0f);
-    suzanneMeshObject->transform.rotation = glm::vec3(1.0f, 1.0f, 2.0f);
+    suzanneMeshObject->transform().setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+    suzanneMeshObject->transform().setRotation(glm::vec3(1.0f, 1.0f, 2.0f));
 
-    teapotMeshObject->transform.position = glm::vec3(-3.0f, 1.0f, 0.0f);
-    teapotMeshObject->transform.scale = glm::vec3(0.5f);
+    teapotMeshObject->transform().setPosition(glm::vec3(-3.0f, 1.0f, 0.0f));
+    teapotMeshObject->transform().setScale(glm::vec3(0.5f));
 
-    surfaceObject->transform.position = glm::vec3(0.0f, 0.1f, -10.0f);
+    surfaceObject->transform().setPosition(glm::vec3(0.0f, 0.1f, -10.0f));
 
     scene->addChild(surfaceObject);
     scene->addChild(lampMeshObject);
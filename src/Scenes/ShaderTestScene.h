@@ -22,7 +22,7 @@ std::shared_ptr<Scene> shaderTestScene() {
     };
 
     std::shared_ptr<GameObject> sphereObject = std::make_shared<GameObject>();
-    sphereObject->transform.position = glm::vec3(0.0f, 0.0f, 0.0f);
+    sphereObject->transform().setPosition(glm::vec3(0.0f, 0.0f, 0.0f));
 
     sphereObject->addComponent(sphereMesh);
     sphereObject->addComponent(std::make_shared<SphereUpdateBehaviour>());
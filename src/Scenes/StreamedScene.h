@@ -0,0 +1,44 @@
+#pragma once
+
+#include <random>
+
+#include <Engine/Engine.h>
+#include <Engine/EngineInternal/Components/Behaviour/RotatorComponent/Rotator.h>
+
+/// Endless field of cubes loaded in 32 x 32 cells around the camera
+std::shared_ptr<SceneStreamer> streamedScene() {
+    const float cellSize = 32.0f;
+
+    return std::make_shared<SceneStreamer>(cellSize, 96.0f, 128.0f, [cellSize](const CellCoord & coord) {
+        /// Same cell always gets the same content
+        std::mt19937 random(static_cast<uint32_t>(CellCoordHash()(coord)));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<CellObject> objects(400);
+
+        for (auto & object : objects) {
+            float r = unit(random);
+            float g = unit(random);
+            float b = unit(random);
+
+            object.position = glm::vec3((static_cast<float>(coord.x) + unit(random)) * cellSize,
+                                        unit(random) * 8.0f,
+                                        (static_cast<float>(coord.z) + unit(random)) * cellSize);
+            object.scale = glm::vec3(0.2f + unit(random) * 0.3f);
+
+            object.mesh = makePooled<MeshComponent>(CUBE);
+            object.renderer = makePooled<MeshRenderer>();
+            object.renderer->shaderType = PHONG;
+            object.renderer->color = glm::vec4(r, g, b, 1.0f);
+            object.renderer->instanced = true;
+
+            if (r > 0.8f) {
+                object.setup = [](GameObject & gameObject) {
+                    gameObject.addComponent(makePooled<Rotator>());
+                };
+            }
+        }
+
+        return objects;
+    });
+}
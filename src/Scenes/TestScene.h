@@ -34,15 +34,15 @@ std::shared_ptr<Scene> testScene() {
         shader->setVec3("lightPos", *lightPos.get());
     };
 
-    auto lampMeshObject = std::make_shared<GameObject>(lampMesh);
-    lampMeshObject->transform.scale = glm::vec3(0.1f);
-    lampMeshObject->transform.position = *lightPos.get();
+    auto lampMeshObject = makePooled<GameObject>(lampMesh);
+    lampMeshObject->transform().setScale(glm::vec3(0.1f));
+    lampMeshObject->transform().setPosition(*lightPos.get());
 
-    auto cubeObject = std::make_shared<GameObject>(cube);
-    cubeObject->transform.position = glm::vec3(0.0f, 0.5f, 0.0f);
+    auto cubeObject = makePooled<GameObject>(cube);
+    cubeObject->transform().setPosition(glm::vec3(0.0f, 0.5f, 0.0f));
 
-    auto surfaceObject = std::make_shared<GameObject>(surface);
-    surfaceObject->transform.position = glm::vec3(0.0f, 1.5f, 0.0f);
+    auto surfaceObject = makePooled<GameObject>(surface);
+    surfaceObject->transform().setPosition(glm::vec3(0.0f, 1.5f, 0.0f));
 
     scene->addChild(surfaceObject);
     scene->addChild(lampMeshObject);
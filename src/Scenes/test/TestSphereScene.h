@@ -8,7 +8,7 @@ std::shared_ptr<Scene> testSphereScene() {
     std::shared_ptr<Scene> scene = std::make_shared<Scene>();
     auto sphereObject = GameObjectFactory::sphere(glm::vec3(0.0f, 3.0f, 0.0f), glm::vec3(0.0f, 0.0f, 10.0f));
 
-    auto rigidbody = std::make_shared<Rigidbody>();
+    auto rigidbody = makePooled<Rigidbody>();
     rigidbody->mass = 1.0f;
     rigidbody->restitution = 0.2f;
 
@@ -4,6 +4,7 @@
 #include <Scenes/test/TestSphereScene.h>
 #include <Engine/Engine.h>
 #include <Scenes/OrthoScene.h>
+#include <Scenes/StreamedScene.h>
 
 void testPhysicsEngine() {
     PhysicsEngine pe;
@@ -23,6 +24,7 @@ void mainEngine() {
     //engine->addScene(testSphereScene());
     engine->addScene(instancedScene());
     //engine->addScene(mainScene());
+    //engine->addStreamedScene(streamedScene());
 
     engine->start();
 
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include <Components/MeshComponent/MeshComponent.h>
+#include <Rendering/Mesh/MeshRenderer/MeshRenderer.h>
+#include <Scene/GameObject/GameObject.h>
+
+/// Transform of object across archetype moves, objects created in their final archetype,
+/// attaching, reparenting and detaching children.
+/// Returns non zero when any check fails.
+
+namespace {
+
+    int failures = 0;
+
+    void check(const bool & condition, const char * message) {
+        if (condition) return;
+
+        std::cerr << "FAILED: " << message << std::endl;
+        failures++;
+    }
+
+    bool contains(const GameObject & object, const std::shared_ptr<GameObject> & child) {
+        return std::find(object.children.begin(), object.children.end(), child) != object.children.end();
+    }
+}
+
+int main() {
+    {
+        auto object = std::make_shared<GameObject>(glm::vec3(1.0f, 2.0f, 3.0f));
+        auto neighbour = std::make_shared<GameObject>();
+
+        object->addComponent(std::make_shared<MeshComponent>(CUBE));
+        neighbour.reset();
+        object->addComponent(std::make_shared<MeshRenderer>());
+
+        auto * stored = World::Instance().tryGet<Transform>(object->entity);
+
+        check(stored && stored->getSlot() == object->transform().getSlot(), "transform follows entity across archetypes");
+
+        object->transform().setPosition(glm::vec3(4.0f));
+
+        check(stored && stored->getPosition() == glm::vec3(4.0f), "writes through transform reach stored transform");
+    }
+
+    {
+        auto & world = World::Instance();
+
+        uint32_t archetype = world.archetypeWith<Transform>(0);
+        archetype = world.archetypeWith<std::shared_ptr<MeshComponent>>(archetype);
+        archetype = world.archetypeWith<std::shared_ptr<MeshRenderer>>(archetype);
+
+        world.reserve(archetype, 1);
+
+        auto object = std::make_shared<GameObject>(world.create(archetype));
+        auto mesh = object->addComponent(std::make_shared<MeshComponent>(CUBE));
+        auto renderer = object->addComponent(std::make_shared<MeshRenderer>());
+
+        auto * stored = world.tryGet<Transform>(object->entity);
+
+        check(stored && stored->getSlot() == object->transform().getSlot(), "created object views its stored transform");
+        check(world.get<std::shared_ptr<MeshComponent>>(object->entity) == mesh &&
+              world.get<std::shared_ptr<MeshRenderer>>(object->entity) == renderer, "components fill columns of created entity");
+    }
+
+    auto first = std::make_shared<GameObject>();
+    auto second = std::make_shared<GameObject>();
+    auto child = std::make_shared<GameObject>();
+
+    first->addChild(child);
+
+    check(contains(*first, child) && child->parent == first.get(), "child is attached to first parent");
+    check(child->transform().hasParent(), "child transform has parent");
+
+    first->addChild(child);
+
+    check(first->children.size() == 1, "attaching twice keeps one entry");
+
+    /// Reference into children of previous parent
+    second->addChild(first->children[0]);
+
+    check(first->children.empty(), "reparented child is removed from previous parent");
+    check(contains(*second, child) && child->parent == second.get(), "reparented child is attached to new parent");
+
+    child->addChild(second);
+
+    check(second->parent == nullptr && child->children.empty(), "ancestor cannot become child of its descendant");
+
+    second->removeChild(child);
+
+    check(second->children.empty() && child->parent == nullptr, "removed child is detached");
+    check(!child->transform().hasParent(), "removed child transform has no parent");
+
+    second->addChild(child);
+
+    long uses = child.use_count();
+    second.reset();
+
+    check(child->parent == nullptr, "destroyed parent is cleared from its children");
+    check(child.use_count() == uses - 1, "destroyed parent releases its children");
+
+    first.reset();
+    child.reset();
+
+    if (failures > 0) return 1;
+
+    std::cout << "GameObject tests passed" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <Rendering/Mesh/MeshCache/MeshCache.h>
+#include <Rendering/Mesh/Primitives/Cube.h>
+#include <Rendering/Mesh/Primitives/Quad.h>
+#include <Rendering/Mesh/Primitives/Surface.h>
+
+/// Converts OBJ models and procedural primitives into cooked meshes (see MeshCache).
+///
+/// Usage: asset_cooker [model.obj ...]
+/// Without arguments cooks all models in ../resources/models. Primitives are always cooked into ../resources/cooked,
+/// paths are relative to build directory, the same as paths used by scenes.
+
+namespace {
+
+    bool cookModel(const std::string & path) {
+        Mesh mesh;
+        mesh.loadFromFile(path);
+
+        if (mesh.vertices.empty()) {
+            std::cerr << "asset_cooker: " << path << " has no vertices" << std::endl;
+            return false;
+        }
+
+        return MeshCache::cook(mesh, MeshCache::cookedPath(path), path);
+    }
+
+    bool cookPrimitive(Mesh && mesh, const std::string & name) {
+        std::cout << "Cooking: " << name << std::endl;
+        return MeshCache::cook(mesh, MeshCache::primitivePath(name));
+    }
+}
+
+int main(int argc, char ** argv) {
+    std::vector<std::string> models;
+
+    for (int i = 1; i < argc; i++) {
+        models.emplace_back(argv[i]);
+    }
+
+    if (models.empty()) {
+        std::error_code error;
+
+        for (auto & entry : std::filesystem::directory_iterator("../resources/models", error)) {
+            if (entry.path().extension() == ".obj") {
+                models.push_back(entry.path().string());
+            }
+        }
+    }
+
+    bool success = true;
+
+    for (auto & model : models) {
+        success &= cookModel(model);
+    }
+
+    std::filesystem::create_directories(std::filesystem::path(MeshCache::primitivePath("")).parent_path());
+
+    success &= cookPrimitive(Quad(), "quad");
+    success &= cookPrimitive(Cube(), "cube");
+    success &= cookPrimitive(Surface(300, 300), "surface_300x300");
+
+    return success ? 0 : 1;
+}